@@ -23,6 +23,7 @@
 // QC
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/UpdatePolicyManager.h"
+#include "QualityControl/LatencyTracing.h"
 
 namespace o2::framework
 {
@@ -167,6 +168,7 @@ class AggregatorRunner : public framework::Task
   int mTotalNumberObjectsReceived;
   int mTotalNumberAggregatorExecuted;
   int mTotalNumberObjectsProduced;
+  core::LatencyStatistics mAggregationLatency; // from the end of the task cycle to the storage of the aggregated QOs
 
   // Service discovery
   std::shared_ptr<core::ServiceDiscovery> mServiceDiscovery;
@@ -19,6 +19,7 @@
 
 #include <tuple>
 #include <functional>
+#include <vector>
 
 namespace o2::quality_control::calculators
 {
@@ -34,6 +35,9 @@ double averageMG1Queue(double rho, double mean, double stddev);
 
 // number of merger layes, M0 is number of producers, R is max reduction factor
 size_t numberOfMergerLayers(size_t M0, size_t R);
+// number of mergers in each layer, M0 is number of producers, R >= 2 is max reduction factor. The last layer has one merger.
+std::vector<size_t> mergersPerLayer(size_t M0, size_t R);
+
 double mergersMemoryUsage(size_t R, size_t M0, size_t objSize, double T, std::function<double(double)> performance);
 
 double mergersCpuUsage(size_t R, size_t M0, double T, std::function<double(double)> performance);
@@ -17,8 +17,11 @@
 #define QC_REPOSITORY_CCDBDATABASE_H
 
 #include <CCDB/CcdbApi.h>
+#include <mutex>
 
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/RetrievalCache.h"
+#include "QualityControl/ThreadPool.h"
 
 namespace o2::quality_control::repository
 {
@@ -78,6 +81,8 @@ class CcdbDatabase : public DatabaseInterface
   // retrieval - general
   std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
   TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) override;
+  /// \brief Retrieves the objects concurrently, with one connection per thread, if "retrievalThreads" is larger than 1.
+  std::vector<RetrievedObject> retrieveMany(const std::vector<RetrievalRequest>& requests) override;
 
   void disconnect() override;
   void prepareTaskDataContainer(std::string taskName) override;
@@ -91,14 +96,17 @@ class CcdbDatabase : public DatabaseInterface
   * @param subpath The folder we want to list the children of.
   * @return The listing of folder and/or objects at the subpath.
   */
-  std::vector<std::string> getListing(std::string subpath = "");
+  std::vector<std::string> getListing(std::string subpath = "") override;
 
   /**
    * \brief Returns a vector of all 'valid from' timestamps for an object.
    * \path Path on an object.
    * \return A vector of all 'valid from' timestamps for an object in non-descending order.
    */
-  std::vector<uint64_t> getTimestampsForObject(std::string path);
+  std::vector<uint64_t> getTimestampsForObject(std::string path) override;
+
+  /// \brief Returns the cache of retrieved objects, nullptr if it is disabled.
+  const RetrievalCache* getRetrievalCache() const { return mRetrievalCache.get(); }
 
  private:
   /**
@@ -109,6 +117,10 @@ class CcdbDatabase : public DatabaseInterface
    */
   static void loadDeprecatedStreamerInfos();
   void init();
+  /// Retrieves the object with the given connection, without logging, so that it can be called by several threads.
+  TObject* retrieveTObject(o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers);
+  /// Retrieves the object from the cache if the server confirms that the cached version is still the one to return.
+  TObject* retrieveCachedTObject(o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>& headers);
 
   /**
    * Return the listing of folder and/or objects in the subpath.
@@ -119,6 +131,11 @@ class CcdbDatabase : public DatabaseInterface
   std::string getListingAsString(std::string subpath = "", std::string accept = "text/plain");
   o2::ccdb::CcdbApi ccdbApi;
   std::string mUrl = "";
+  std::unique_ptr<RetrievalCache> mRetrievalCache;
+  std::mutex mRetrievalCacheMutex;
+  size_t mRetrievalThreads = 1;
+  std::vector<std::unique_ptr<o2::ccdb::CcdbApi>> mRetrievalApis; // one per thread of mRetrievalPool
+  std::unique_ptr<core::ThreadPool> mRetrievalPool;
 };
 
 } // namespace o2::quality_control::repository
@@ -24,6 +24,7 @@
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/CheckInterface.h"
+#include "QualityControl/MonitorObjectsView.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/CheckConfig.h"
 
@@ -56,6 +57,14 @@ class Check
    */
   void init();
 
+  /**
+   * \brief Runs the check on the objects it subscribed to and beautifies them.
+   *
+   * It does not log, so that it can be invoked concurrently for different Checks. The map is only read.
+   *
+   * @param moMap The objects to choose from, with their full names.
+   * @return One QualityObject, or one per checked object in case of the OnEachSeparately policy.
+   */
   QualityObjectsType check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap);
 
   /**
@@ -83,7 +92,9 @@ class Check
  private:
   void initConfig(std::string checkName);
 
-  void beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, Quality quality);
+  /// Checks the objects in the view and beautifies them.
+  std::shared_ptr<QualityObject> check(const MonitorObjectsView& moView);
+  void beautify(const MonitorObjectsView& moView, Quality quality);
 
   std::string mConfigurationSource;
   o2::quality_control::core::QcInfoLogger& mLogger;
@@ -97,6 +108,8 @@ class Check
   o2::framework::OutputSpec mOutputSpec;
 
   bool mBeautify = true;
+  // Pointers to the entries of the checked map which are passed to the CheckInterface, reused between invocations
+  std::vector<const MonitorObjectsView::value_type*> mObjectsToCheck;
 };
 
 } // namespace o2::quality_control::checker
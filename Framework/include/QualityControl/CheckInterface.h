@@ -19,6 +19,7 @@
 #include <unordered_map>
 
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectsView.h"
 #include "QualityControl/Quality.h"
 
 using namespace o2::quality_control::core;
@@ -51,6 +52,16 @@ class CheckInterface
   /// @return The quality associated with these objects.
   virtual Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) = 0;
 
+  /// \brief Returns the quality associated with the objects in the view.
+  ///
+  /// This is the method invoked by the framework. By default, it copies the objects into a map and passes it to the
+  /// map-based check(), so that existing checks keep working unchanged. A check can override it to avoid the copy.
+  /// In such case, it can implement the map-based check() with checkMapThroughView().
+  ///
+  /// @param moView A view of the MonitorObjects to check and their full names, valid only during the call.
+  /// @return The quality associated with these objects.
+  virtual Quality checkView(const MonitorObjectsView& moView);
+
   /// \brief Modify the aspect of the plot.
   ///
   /// Modify the aspect of the plot.
@@ -78,6 +89,9 @@ class CheckInterface
   void setCustomParameters(const std::unordered_map<std::string, std::string>& parameters);
 
  protected:
+  /// \brief Passes all the objects of the map to checkView(), for checks which are implemented with the view.
+  Quality checkMapThroughView(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap);
+
   std::unordered_map<std::string, std::string> mCustomParameters;
 
   ClassDef(CheckInterface, 2)
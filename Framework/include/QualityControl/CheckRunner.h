@@ -22,6 +22,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <unordered_set>
 // O2
@@ -34,10 +35,13 @@
 // QC
 #include "QualityControl/CheckInterface.h"
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/StorageQueue.h"
+#include "QualityControl/ThreadPool.h"
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/Check.h"
 #include "QualityControl/UpdatePolicyManager.h"
+#include "QualityControl/LatencyTracing.h"
 
 namespace o2::quality_control::core
 {
@@ -128,6 +132,8 @@ class CheckRunner : public framework::Task
    * The Check's associated with this MonitorObject are run and a global quality is built by
    * taking the worse quality encountered. The MonitorObject is modified by setting its quality
    * and by calling the "beautifying" methods of the Check's.
+   * If the check pool is enabled, the ready Check's are run concurrently, except for those which share objects.
+   * In any case, the QualityObjects are returned in the order of the Check's in the configuration.
    *
    * @param mo The MonitorObject to evaluate and whose quality will be set according
    *        to the worse quality encountered while running the Check's.
@@ -137,6 +143,8 @@ class CheckRunner : public framework::Task
   /**
    * \brief Store the QualityObjects in the database.
    *
+   * If the storage queue is enabled, the objects are only scheduled for storage and this method does not block.
+   *
    * @param qualityObjects QOs to be stored in DB.
    */
   void store(QualityObjectsType& qualityObjects);
@@ -144,6 +152,8 @@ class CheckRunner : public framework::Task
   /**
    * \brief Store the MonitorObjects in the database.
    *
+   * If the storage queue is enabled, the objects are only scheduled for storage and this method does not block.
+   *
    * @param monitorObjects MOs to be stored in DB.
    */
   void store(std::vector<std::shared_ptr<MonitorObject>>& monitorObjects);
@@ -161,6 +171,7 @@ class CheckRunner : public framework::Task
   static o2::framework::Outputs collectOutputs(const std::vector<Check>& checks);
 
   inline void initDatabase();
+  inline void initCheckPool();
   inline void initMonitoring();
   inline void initServiceDiscovery();
 
@@ -197,6 +208,7 @@ class CheckRunner : public framework::Task
   std::vector<Check> mChecks;
   o2::quality_control::core::QcInfoLogger& mLogger;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::unique_ptr<o2::quality_control::repository::StorageQueue> mStorageQueue; // null if objects are stored synchronously
   std::unordered_set<std::string> mInputStoreSet;
   std::vector<std::shared_ptr<MonitorObject>> mMonitorObjectStoreVector;
   std::shared_ptr<o2::configuration::ConfigurationInterface> mConfigFile;
@@ -209,6 +221,10 @@ class CheckRunner : public framework::Task
   // Checks cache
   std::map<std::string, std::shared_ptr<MonitorObject>> mMonitorObjects;
 
+  // Parallel checks
+  std::unique_ptr<o2::quality_control::core::ThreadPool> mCheckPool; // null if the checks are run sequentially
+  std::vector<std::shared_ptr<std::mutex>> mCheckGuards;             // one per Check, shared by Checks with common objects
+
   // Service discovery
   std::shared_ptr<ServiceDiscovery> mServiceDiscovery;
   std::unordered_set<std::string> mListAllQOPaths; // store the names of all the QOs the Checks have generated so far
@@ -219,6 +235,11 @@ class CheckRunner : public framework::Task
   int mTotalNumberCheckExecuted;
   int mTotalNumberQOStored;
   int mTotalNumberMOStored;
+  double mCheckDurationInPeriod = 0;   // time spent in check() since the last periodic monitoring, in seconds
+  double mMaxCheckDurationInPeriod = 0; // the longest check() since the last periodic monitoring, in seconds
+  int mNumberOfCheckCallsInPeriod = 0;
+  core::LatencyStatistics mReceptionLatency; // from the publication of MOs by tasks to their reception
+  core::LatencyStatistics mStorageLatency;   // from the end of the task cycle to the storage of QOs
   AliceO2::Common::Timer mTimer;
 };
 
@@ -16,6 +16,7 @@
 #ifndef QC_REPOSITORY_DATABASEINTERFACE_H
 #define QC_REPOSITORY_DATABASEINTERFACE_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -37,6 +38,18 @@ class DatabaseInterface
  public:
   constexpr static framework::ServiceKind service_kind = framework::ServiceKind::Global;
 
+  /// \brief One of the objects to be retrieved by retrieveMany.
+  struct RetrievalRequest {
+    std::string path;
+    long timestamp = -1;
+    std::map<std::string, std::string> metadata = {};
+  };
+  /// \brief An object returned by retrieveMany, with the headers received with it. The object is null if not found.
+  struct RetrievedObject {
+    std::unique_ptr<TObject> object;
+    std::map<std::string, std::string> headers;
+  };
+
   /// Default constructor
   DatabaseInterface() = default;
   /// Destructor
@@ -140,6 +153,23 @@ class DatabaseInterface
    * \param metadata filters under the form of key-value pairs to select data
    */
   virtual TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) = 0;
+  /**
+   * \brief Look up several objects and return them.
+   * The objects are returned in the order of the requests, the missing ones as nullptr. Implementations may retrieve
+   * them concurrently, this default one calls retrieveTObject for each of them.
+   * \param requests paths, timestamps and metadata filters of the objects
+   */
+  virtual std::vector<RetrievedObject> retrieveMany(const std::vector<RetrievalRequest>& requests);
+  /**
+   * \brief Converts an object returned by retrieveMany to a MonitorObject, as retrieveMO would return it.
+   * Returns nullptr if there is no object.
+   */
+  static std::shared_ptr<o2::quality_control::core::MonitorObject> toMonitorObject(RetrievedObject&& retrieved);
+  /**
+   * \brief Converts an object returned by retrieveMany to a QualityObject, as retrieveQO would return it.
+   * Returns nullptr if there is no object or if it is not a QualityObject.
+   */
+  static std::shared_ptr<o2::quality_control::core::QualityObject> toQualityObject(RetrievedObject&& retrieved);
 
   /**
    * \brief Look up a monitor object and return it in JSON format.
@@ -184,6 +214,18 @@ class DatabaseInterface
    */
   virtual void prepareTaskDataContainer(std::string taskName) = 0;
   virtual std::vector<std::string> getPublishedObjectNames(std::string taskName) = 0;
+  /**
+   * \brief Returns the listing of folders and/or objects in the subpath.
+   * \param subpath The folder we want to list the children of.
+   * \return The listing of folders and/or objects at the subpath.
+   */
+  virtual std::vector<std::string> getListing(std::string subpath = "") = 0;
+  /**
+   * \brief Returns a vector of all 'valid from' timestamps for an object.
+   * \param path Path of the object.
+   * \return A vector of all 'valid from' timestamps for the object in non-descending order.
+   */
+  virtual std::vector<uint64_t> getTimestampsForObject(std::string path) = 0;
   /**
    * Delete all versions of a given object
    * @param taskName Task sending the object
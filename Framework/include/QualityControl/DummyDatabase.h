@@ -51,6 +51,8 @@ class DummyDatabase : public DatabaseInterface
   void disconnect() override;
   void prepareTaskDataContainer(std::string taskName) override;
   std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  std::vector<std::string> getListing(std::string subpath = "") override;
+  std::vector<uint64_t> getTimestampsForObject(std::string path) override;
   void truncate(std::string taskName, std::string objectName) override;
 
  private:
@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyTracing.h
+/// \author Piotr Konopka
+///
+/// \brief Metadata which follow the objects along the QC chain, to measure how long they take to reach each stage.
+///
+/// The TaskRunner stamps the MonitorObjects it publishes with its cycle number and the times at which it finished the
+/// cycle and published the objects. The tracing metadata are kept by Mergers (the most recent version wins) and copied
+/// by Checks to the QualityObjects they produce, so that the CheckRunner and the AggregatorRunner can tell how old
+/// the data are when they reach them. The timestamps are milliseconds since epoch taken on the machine of each stage,
+/// so the measured latencies are only as accurate as the synchronisation of their clocks.
+
+#ifndef QC_CORE_LATENCYTRACING_H
+#define QC_CORE_LATENCYTRACING_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+namespace latency_tracing
+{
+
+constexpr char cycleKey[] = "qc_cycle";           ///< number of the task cycle which produced the data
+constexpr char cycleEndKey[] = "qc_cycle_end";    ///< time when the task finished the cycle, before endOfCycle()
+constexpr char publicationKey[] = "qc_published"; ///< time when the task sent the MonitorObject
+constexpr char checkKey[] = "qc_checked";         ///< time when the QualityObject was produced by its Check
+
+/// \return current time in milliseconds since epoch
+uint64_t now();
+
+/// \return the tracing metadata of the task found in the map (cycle, cycle end, publication)
+std::map<std::string, std::string> getTaskMetadata(const std::map<std::string, std::string>& metadata);
+
+/// \return true if the first metadata were published by a task later than the second ones.
+/// Metadata without a publication time are older than any other.
+bool isPublishedLater(const std::map<std::string, std::string>& first, const std::map<std::string, std::string>& second);
+
+/// \return seconds elapsed between the time stored in the metadata under the key and the reference time,
+///         nothing if the metadata do not contain a valid time.
+std::optional<double> getSecondsSince(const std::map<std::string, std::string>& metadata, const char* key, uint64_t reference = now());
+
+} // namespace latency_tracing
+
+/// \brief Collects latency samples and provides their quantiles.
+///
+/// It is meant to be reset after each monitoring period, all the samples of a period are kept.
+class LatencyStatistics
+{
+ public:
+  void add(double seconds) { mSamples.push_back(seconds); }
+  size_t size() const { return mSamples.size(); }
+  bool empty() const { return mSamples.empty(); }
+  void reset() { mSamples.clear(); }
+
+  /// \brief Returns the smallest sample which is greater or equal to the fraction q of all the samples.
+  /// \param q fraction between 0 and 1, e.g. 0.5 for the median, 0.99 for the 99th percentile
+  /// \return the quantile, 0 if there are no samples.
+  double getQuantile(double q);
+
+ private:
+  std::vector<double> mSamples;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_LATENCYTRACING_H
@@ -0,0 +1,111 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalDatabase.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_REPOSITORY_LOCALDATABASE_H
+#define QC_REPOSITORY_LOCALDATABASE_H
+
+#include <filesystem>
+#include <optional>
+
+#include "QualityControl/DatabaseInterface.h"
+
+class TClass;
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Repository in a local directory, which does not need any server.
+///
+/// Each version of an object is a ROOT file in the directory tree which follows the object path:
+///   <root>/<object path>/<valid from>_<valid until>_<creation time>[_<sequence>].root
+/// The sequence number is added only to the versions created in the same millisecond as an existing one.
+/// The file contains the object under the key "ccdb_object" and its metadata under the key "ccdb_meta", like the
+/// files stored in the CCDB. The validity of the versions is known from the file names, so that finding the version
+/// to retrieve does not require opening any file, unless the metadata have to be matched.
+/// As in the CCDB, the version valid at the requested time which has the latest start of validity is returned.
+///
+/// The files are written under a temporary name and linked to their final name, so that a process reading the same
+/// directory never sees a partially written object, and a version is never replaced by another one. The class itself is not thread-safe, but several instances can use the same
+/// directory.
+///
+/// Configuration: "path" is the root directory of the repository. It is created if it does not exist.
+class LocalDatabase : public DatabaseInterface
+{
+ public:
+  LocalDatabase() = default;
+  ~LocalDatabase() override = default;
+
+  /// \param host is used as the root directory of the repository, the other parameters are ignored.
+  void connect(std::string host, std::string database, std::string username, std::string password) override;
+  void connect(const std::unordered_map<std::string, std::string>& config) override;
+
+  // storage
+  void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo, long from = -1, long to = -1) override;
+  void storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo, long from = -1, long to = -1) override;
+  void storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                std::string const& detectorName, std::string const& taskName, long from = -1, long to = -1) override;
+
+  void* retrieveAny(std::type_info const& tinfo, std::string const& path,
+                    std::map<std::string, std::string> const& metadata, long timestamp = -1,
+                    std::map<std::string, std::string>* headers = nullptr,
+                    const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") override;
+
+  // retrieval - MO - deprecated
+  std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string taskName, std::string objectName, long timestamp = -1) override;
+  std::string retrieveMOJson(std::string taskName, std::string objectName, long timestamp = -1) override;
+
+  // retrieval - QO - deprecated
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = -1) override;
+  std::string retrieveQOJson(std::string qoPath, long timestamp = -1) override;
+
+  // retrieval - general
+  std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) override;
+
+  void disconnect() override;
+  void prepareTaskDataContainer(std::string taskName) override;
+  std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  /// Removes all the versions of the object. The object name "*" removes all the objects of the task.
+  void truncate(std::string taskName, std::string objectName) override;
+  /// \brief Returns the paths of all the objects below the subpath.
+  std::vector<std::string> getListing(std::string subpath = "") override;
+  std::vector<uint64_t> getTimestampsForObject(std::string path) override;
+
+ private:
+  struct ObjectVersion {
+    long validFrom = 0;
+    long validUntil = 0;
+    long created = 0;
+    int sequence = 0; // orders the versions created in the same millisecond
+    std::filesystem::path file;
+  };
+
+  std::filesystem::path getDirectory(const std::string& path) const;
+  /// Returns the versions of the object, sorted by the start of validity and then by creation time and sequence.
+  std::vector<ObjectVersion> getVersions(const std::string& path) const;
+  /// Returns the version to be retrieved according to the CCDB rules, if any.
+  std::optional<ObjectVersion> findVersion(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp,
+                                           const std::string& createdNotAfter, const std::string& createdNotBefore) const;
+  void store(const void* obj, const TClass* cl, const std::string& path, std::map<std::string, std::string> metadata, long from, long to);
+  /// Reads the object from the file, returns nullptr if it is not of the expected class (or derived from it).
+  void* read(const ObjectVersion& version, TClass* expected, std::map<std::string, std::string>* headers) const;
+  static std::map<std::string, std::string> readMetadata(const std::filesystem::path& file);
+
+  std::filesystem::path mRoot;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_LOCALDATABASE_H
@@ -0,0 +1,122 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectsView.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_CHECKER_MONITOROBJECTSVIEW_H
+#define QC_CHECKER_MONITOROBJECTSVIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "QualityControl/MonitorObject.h"
+
+namespace o2::quality_control::checker
+{
+
+/// \brief Non-owning, read-only view of MonitorObjects and their full names.
+///
+/// It refers to entries of a map owned by someone else (typically the CheckRunner's cache), through an array of
+/// pointers to them, so that a subset of the objects can be passed to a check without copying them into a new map.
+/// The view and the iterators are valid as long as the array and the referenced map entries are.
+class MonitorObjectsView
+{
+ public:
+  using MonitorObjectsMap = std::map<std::string, std::shared_ptr<core::MonitorObject>>;
+  using value_type = MonitorObjectsMap::value_type;
+
+  class const_iterator
+  {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = MonitorObjectsView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    explicit const_iterator(const value_type* const* position) : mPosition(position) {}
+
+    reference operator*() const { return **mPosition; }
+    pointer operator->() const { return *mPosition; }
+    reference operator[](difference_type n) const { return *mPosition[n]; }
+
+    const_iterator& operator++()
+    {
+      ++mPosition;
+      return *this;
+    }
+    const_iterator operator++(int) { return const_iterator(mPosition++); }
+    const_iterator& operator--()
+    {
+      --mPosition;
+      return *this;
+    }
+    const_iterator operator--(int) { return const_iterator(mPosition--); }
+    const_iterator& operator+=(difference_type n)
+    {
+      mPosition += n;
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n)
+    {
+      mPosition -= n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const { return const_iterator(mPosition + n); }
+    const_iterator operator-(difference_type n) const { return const_iterator(mPosition - n); }
+    difference_type operator-(const const_iterator& other) const { return mPosition - other.mPosition; }
+
+    bool operator==(const const_iterator& other) const { return mPosition == other.mPosition; }
+    bool operator!=(const const_iterator& other) const { return mPosition != other.mPosition; }
+    bool operator<(const const_iterator& other) const { return mPosition < other.mPosition; }
+
+   private:
+    const value_type* const* mPosition = nullptr;
+  };
+
+  MonitorObjectsView() = default;
+  /// \param entries Array of pointers to the viewed map entries.
+  /// \param size    Number of pointers in the array.
+  MonitorObjectsView(const value_type* const* entries, size_t size) : mEntries(entries), mSize(size) {}
+
+  const_iterator begin() const { return const_iterator(mEntries); }
+  const_iterator end() const { return const_iterator(mEntries + mSize); }
+  size_t size() const { return mSize; }
+  bool empty() const { return mSize == 0; }
+
+  /// \brief Returns the MonitorObject with the given full name, or nullptr if it is not in the view.
+  std::shared_ptr<core::MonitorObject> find(const std::string& name) const
+  {
+    for (const auto& [moName, mo] : *this) {
+      if (moName == name) {
+        return mo;
+      }
+    }
+    return nullptr;
+  }
+
+  /// \brief Copies the viewed entries into a map.
+  MonitorObjectsMap toMap() const { return MonitorObjectsMap(begin(), end()); }
+
+ private:
+  const value_type* const* mEntries = nullptr;
+  size_t mSize = 0;
+};
+
+} // namespace o2::quality_control::checker
+
+#endif // QC_CHECKER_MONITOROBJECTSVIEW_H
@@ -21,8 +21,10 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/TaskConfig.h"
 // stl
+#include <array>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 class TObject;
 class TObjArray;
@@ -85,15 +87,32 @@ class ObjectsManager
   bool isBeingPublished(const std::string& name);
 
   /**
-   * Returns the published MonitorObject specified by its name
+   * Returns the published MonitorObject specified by its name.
+   * The look-up is done in constant time.
    * @param objectName The name of the object to find.
    * @return A pointer to the MonitorObject.
    * @throw ObjectNotFoundError if the object is not found.
    */
-  MonitorObject* getMonitorObject(std::string objectName);
+  MonitorObject* getMonitorObject(const std::string& objectName);
 
   MonitorObjectCollection* getNonOwningArray() const;
 
+  /**
+   * \brief Returns a non-owning array of the objects which were modified since the last call.
+   * Histograms (TH1 and THnBase) are considered as modified if their number of entries or sums of weights changed.
+   * Other objects are always considered as modified, as well as objects whose metadata was changed via this class.
+   * Objects which were not returned by the last keepAliveCalls calls are returned anyway, so that the consumers get
+   * them from time to time even if they do not change. 0 means that unmodified objects are never returned.
+   * The array is created with new and must be deleted by the caller.
+   */
+  MonitorObjectCollection* getNonOwningArrayOfModified(size_t keepAliveCalls = 0);
+
+  /**
+   * \brief Consider the current state of all the objects as not modified.
+   * Typically used after the objects are reset, so an empty histogram is not sent again.
+   */
+  void markAllAsUnmodified();
+
   /**
    * \brief Add metadata to a MonitorObject.
    * Add a metadata pair to a MonitorObject. This is propagated to the database.
@@ -164,7 +183,18 @@ class ObjectsManager
   void removeAllFromServiceDiscovery();
 
  private:
+  /// Cheap summary of the content of an object, used to detect modifications.
+  using ContentSummary = std::array<double, 3>;
+  static bool summarizeContent(const TObject* object, ContentSummary& summary);
+  struct PublicationState {
+    ContentSummary content;
+    size_t skippedCalls = 0; // consecutive calls which did not return the object
+  };
+  void markAsModified(const MonitorObject* mo);
+
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
+  std::unordered_map<std::string, MonitorObject*> mMonitorObjectsByName; // index of mMonitorObjects, for fast look-ups
+  std::unordered_map<const MonitorObject*, PublicationState> mLastPublishedContent;
   std::string mTaskName;
   std::string mDetectorName;
   std::unique_ptr<ServiceDiscovery> mServiceDiscovery;
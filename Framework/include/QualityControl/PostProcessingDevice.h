@@ -18,6 +18,7 @@
 
 #include <Framework/Task.h>
 #include <Framework/DataProcessorSpec.h>
+#include <Framework/CompletionPolicy.h>
 #include <Headers/DataHeader.h>
 
 #include <string>
@@ -47,6 +48,7 @@ class PostProcessingDevice : public framework::Task
   void run(framework::ProcessingContext&) override;
 
   const std::string& getDeviceName();
+  /// \brief Returns the timer input and the outputs of the Checks awaited by the 'newobject:check' triggers
   framework::Inputs getInputsSpecs();
   framework::Outputs getOutputSpecs();
   framework::Options getOptions();
@@ -57,6 +59,8 @@ class PostProcessingDevice : public framework::Task
   static header::DataOrigin createPostProcessingDataOrigin();
   /// \brief Unified DataDescription naming scheme for all Post-processing tasks
   static header::DataDescription createPostProcessingDataDescription(const std::string& taskName);
+  /// \brief Lets the devices run as soon as any of the timer or the Checks they wait for sends something
+  static void customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies);
 
  private:
   /// \brief Callback for CallbackService::Id::Start (DPL) a.k.a. RUN transition (FairMQ)
@@ -19,11 +19,13 @@
 #include <memory>
 #include <functional>
 #include <Framework/ServiceRegistry.h>
+#include <Common/Timer.h>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include "QualityControl/PostProcessingInterface.h"
 #include "QualityControl/PostProcessingConfig.h"
 #include "QualityControl/Triggers.h"
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/RetrievalCache.h"
 #include "QualityControl/ObjectsManager.h"
 #include "QualityControl/MonitorObjectCollection.h"
 
@@ -32,6 +34,11 @@ namespace o2::framework
 class DataAllocator;
 } // namespace o2::framework
 
+namespace o2::monitoring
+{
+class Monitoring;
+} // namespace o2::monitoring
+
 namespace o2::quality_control::postprocessing
 {
 
@@ -70,12 +77,26 @@ class PostProcessingRunner
   /// \param callback MonitorObjectCollection publication callback
   void setPublicationCallback(MOCPublicationCallback callback);
 
+  /// \brief Sets where the results of the Checks received from the QC workflow are reported.
+  ///
+  /// It has to be set before start() by the device running the task in a QC workflow. Without it, the
+  /// 'newobject:check' triggers are rejected, as there is nothing to deliver the results of the Checks.
+  void setObjectNotifications(std::shared_ptr<ObjectNotifications> notifications);
+
+  /// \brief Reports a new result of the Check, which was received from the QC workflow.
+  ///
+  /// The 'newobject:check' triggers waiting for it are up at the next run().
+  /// \param timestamp Time of the reception (ms since epoch)
+  void notifyNewCheckResult(const std::string& checkName, uint64_t timestamp = Trigger::msSinceEpoch());
+
   const std::string& getName();
 
  private:
   void doInitialize(Trigger trigger);
   void doUpdate(Trigger trigger);
   void doFinalize(Trigger trigger);
+  void initMonitoring(const boost::property_tree::ptree& config);
+  void sendMetrics();
 
   enum class TaskState {
     INVALID,
@@ -87,6 +108,7 @@ class PostProcessingRunner
   std::vector<TriggerFcn> mInitTriggers;
   std::vector<TriggerFcn> mUpdateTriggers;
   std::vector<TriggerFcn> mStopTriggers;
+  std::shared_ptr<ObjectNotifications> mObjectNotifications = nullptr;
 
   std::unique_ptr<PostProcessingInterface> mTask;
   framework::ServiceRegistry mServices;
@@ -98,6 +120,9 @@ class PostProcessingRunner
   std::string mConfigPath = "";
   PostProcessingConfig mConfig;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  const o2::quality_control::repository::RetrievalCache* mRetrievalCache = nullptr;
+  std::shared_ptr<o2::monitoring::Monitoring> mCollector;
+  AliceO2::Common::Timer mTimer;
 };
 
 MOCPublicationCallback publishToDPL(o2::framework::DataAllocator&, std::string outputBinding);
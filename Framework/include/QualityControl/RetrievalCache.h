@@ -0,0 +1,89 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RetrievalCache.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_REPOSITORY_RETRIEVALCACHE_H
+#define QC_REPOSITORY_RETRIEVALCACHE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <TObject.h>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Least-recently-used cache of the objects retrieved from a repository.
+///
+/// The versions of an object are indexed by path, metadata filter and validity interval. The cache does not decide
+/// whether a cached version is still the one the repository would return, the user is expected to revalidate it,
+/// e.g. with its ETag. The total size of the entries is kept below the budget given at construction.
+/// It is not thread-safe.
+class RetrievalCache
+{
+ public:
+  struct Entry {
+    std::unique_ptr<TObject> object;
+    std::map<std::string, std::string> headers; ///< headers received with the object
+    std::string etag;                           ///< identifier of the version in the repository
+    long validFrom = 0;
+    long validUntil = 0; ///< exclusive
+    size_t bytes = 0;    ///< approximate size of the object in memory
+  };
+
+  struct Statistics {
+    size_t hits = 0;      ///< retrievals served from the cache
+    size_t misses = 0;    ///< retrievals which needed to download the object
+    size_t evictions = 0; ///< entries removed to respect the budget
+    size_t bytes = 0;     ///< current size of the entries
+    size_t entries = 0;   ///< current number of entries
+  };
+
+  /// \param budget Maximum total size of the entries in bytes.
+  explicit RetrievalCache(size_t budget);
+
+  /// \brief Returns the cached version of the object valid at the timestamp, nullptr if there is none.
+  /// It becomes the most recently used entry. The pointer is valid until the next insertion.
+  const Entry* find(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp);
+  /// \brief Inserts a version of the object, replacing the one with the same start of validity.
+  /// The least recently used entries are evicted to respect the budget. Entries larger than the budget are ignored.
+  void insert(const std::string& path, const std::map<std::string, std::string>& metadata, std::unique_ptr<Entry> entry);
+
+  void recordHit() { mStatistics.hits++; }
+  void recordMiss() { mStatistics.misses++; }
+  const Statistics& getStatistics() const { return mStatistics; }
+  size_t getBudget() const { return mBudget; }
+
+ private:
+  struct Node {
+    std::string key;
+    std::unique_ptr<Entry> entry;
+  };
+  using Nodes = std::list<Node>;
+
+  static std::string makeKey(const std::string& path, const std::map<std::string, std::string>& metadata);
+  void erase(Nodes::iterator node);
+
+  const size_t mBudget;
+  Nodes mNodes;                                                                  // the most recently used first
+  std::unordered_map<std::string, std::map<long, Nodes::iterator>> mVersions; // versions by start of validity, per key
+  Statistics mStatistics;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_RETRIEVALCACHE_H
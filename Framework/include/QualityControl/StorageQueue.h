@@ -0,0 +1,119 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   StorageQueue.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_REPOSITORY_STORAGEQUEUE_H
+#define QC_REPOSITORY_STORAGEQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/LatencyTracing.h"
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Bounded queue which stores MonitorObjects and QualityObjects in the repository in the background.
+///
+/// Objects are pushed by the caller and written by a configurable number of worker threads, each of them owning
+/// its own DatabaseInterface instance. If an object with the same path is still waiting in the queue when a newer
+/// version arrives, only the newest one is kept (coalescing). When the queue is full, new objects are dropped.
+/// The start of validity is taken when an object is pushed, so that it does not depend on the queue latency.
+///
+/// Workers do not log (InfoLogger is not thread safe), the outcome is available through getStatistics().
+class StorageQueue
+{
+ public:
+  using DatabaseCreator = std::function<std::unique_ptr<DatabaseInterface>()>;
+
+  struct Config {
+    size_t threads = 1;      ///< number of worker threads, each with its own database connection
+    size_t capacity = 10000; ///< maximum number of distinct paths waiting to be stored
+    size_t batchSize = 100;  ///< maximum number of objects taken at once by a worker
+  };
+
+  struct Statistics {
+    size_t pushed = 0;    ///< objects accepted in the queue
+    size_t storedMOs = 0; ///< MonitorObjects successfully stored
+    size_t storedQOs = 0; ///< QualityObjects successfully stored
+    size_t coalesced = 0; ///< objects replaced by a newer version of the same path before being stored
+    size_t dropped = 0;   ///< objects rejected because the queue was full
+    size_t failed = 0;    ///< objects which could not be stored due to an error
+    size_t pending = 0;   ///< objects waiting in the queue at the moment of the call
+  };
+
+  /// \param databaseCreator Creates and connects a database instance. It is called once per worker thread.
+  /// \param config Sizing of the queue.
+  StorageQueue(DatabaseCreator databaseCreator, Config config);
+  /// Stores what is left in the queue and stops the workers.
+  ~StorageQueue();
+
+  StorageQueue(const StorageQueue&) = delete;
+  StorageQueue& operator=(const StorageQueue&) = delete;
+
+  /// \brief Schedules the MonitorObject for storage.
+  /// \return false if it was dropped because the queue is full.
+  bool push(std::shared_ptr<const core::MonitorObject> mo);
+  /// \brief Schedules the QualityObject for storage.
+  /// \return false if it was dropped because the queue is full.
+  bool push(std::shared_ptr<const core::QualityObject> qo);
+
+  /// \brief Blocks until all the objects pushed so far are stored (or failed).
+  void flush();
+
+  Statistics getStatistics() const;
+  /// \brief Returns the last error reported by a worker and clears it.
+  std::string popLastError();
+  /// \brief Returns the time from the end of the task cycle to the storage of the QualityObjects stored since the
+  /// previous call, for those which carry the latency tracing metadata.
+  core::LatencyStatistics popStorageLatency();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const core::MonitorObject> mo;
+    std::shared_ptr<const core::QualityObject> qo;
+    long validFrom = -1;
+  };
+
+  bool enqueue(const std::string& path, Entry&& entry);
+  void runWorker(std::unique_ptr<DatabaseInterface> database);
+  void store(DatabaseInterface& database, const Entry& entry);
+
+  const Config mConfig;
+
+  mutable std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mWorkDone;
+  std::deque<std::string> mOrder;                  // FIFO of paths waiting to be stored
+  std::unordered_map<std::string, Entry> mPending; // newest version of each path waiting to be stored
+  size_t mInFlight = 0;
+  bool mStopping = false;
+  std::string mLastError;
+  Statistics mStatistics;
+  core::LatencyStatistics mStorageLatency;
+
+  std::vector<std::thread> mWorkers;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_STORAGEQUEUE_H
@@ -35,6 +35,8 @@ struct TaskConfig {
   std::string detectorName = "MISC"; // intended to be the 3 letters code
   int parallelTaskID = 0;            // ID to differentiate parallel local Tasks from one another. 0 means this is the only one.
   std::string saveToFile = "";
+  bool publishOnlyModified = false; // if true, objects which did not change since the last cycle are not sent
+  size_t publishOnlyModifiedKeepAlive = 10; // unmodified objects are sent anyway after so many cycles, 0 to disable
 };
 
 } // namespace o2::quality_control::core
@@ -116,7 +116,8 @@ class TaskRunner : public framework::Task
   void endOfActivity();
   void startCycle();
   void finishCycle(framework::DataAllocator& outputs);
-  int publish(framework::DataAllocator& outputs);
+  /// Sends the objects, stamped with the latency tracing metadata
+  int publish(framework::DataAllocator& outputs, uint64_t cycleEndTime);
   void publishCycleStats();
   void saveToFile();
 
@@ -132,6 +133,7 @@ class TaskRunner : public framework::Task
 
   std::string validateDetectorName(std::string name) const;
   boost::property_tree::ptree getTaskConfigTree() const;
+  bool hasOnAllChecks() const; // whether this task feeds Checks with the policy OnAll
   void updateMonitoringStats(framework::ProcessingContext& pCtx);
   void computeRunNumber(const framework::ServiceRegistry& services);
 
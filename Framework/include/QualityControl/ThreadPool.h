@@ -0,0 +1,58 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_CORE_THREADPOOL_H
+#define QC_CORE_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Fixed number of threads executing the submitted jobs in the order of submission.
+///
+/// The outcome of a job, including an exception it might throw, is available through the returned future.
+/// The jobs which are still queued when the pool is destroyed are executed before the threads are joined.
+class ThreadPool
+{
+ public:
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  std::future<void> submit(std::function<void()> job);
+  size_t size() const { return mThreads.size(); }
+
+ private:
+  void run();
+
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::deque<std::packaged_task<void()>> mJobs;
+  bool mStopping = false;
+  std::vector<std::thread> mThreads;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_THREADPOOL_H
@@ -22,14 +22,17 @@ namespace o2::quality_control::postprocessing::trigger_helpers
 {
 
 /// \brief  Creates a trigger function by taking its corresponding name.
-TriggerFcn triggerFactory(std::string trigger, const PostProcessingConfig& config);
+/// \param notifications Objects received from the QC workflow, required by the 'newobject:check' triggers.
+TriggerFcn triggerFactory(std::string trigger, const PostProcessingConfig& config, std::shared_ptr<const ObjectNotifications> notifications = nullptr);
 /// \brief Creates a trigger function vector given trigger names
-std::vector<TriggerFcn> createTriggers(const std::vector<std::string>& triggerNames, const PostProcessingConfig& config);
+std::vector<TriggerFcn> createTriggers(const std::vector<std::string>& triggerNames, const PostProcessingConfig& config, std::shared_ptr<const ObjectNotifications> notifications = nullptr);
 /// \brief Executes a vector of triggers functions and returns the first trigger which is not TriggerType::No
 Trigger tryTrigger(std::vector<TriggerFcn>&);
 /// \brief Checks if in a given trigger configuration vector there is a UserOrControl trigger.
 /// This is trigger cannot be checked as all the others, so we just check if it is requested in the right moments.
 bool hasUserOrControlTrigger(const std::vector<std::string>&);
+/// \brief Returns the names of the Checks whose results are awaited by the 'newobject:check:<name>' triggers.
+std::vector<std::string> getCheckNamesInTriggers(const std::vector<std::string>& triggerNames);
 
 } // namespace o2::quality_control::postprocessing::trigger_helpers
 
@@ -19,6 +19,8 @@
 #include <string>
 #include <functional>
 #include <iosfwd>
+#include <map>
+#include <memory>
 
 namespace o2::quality_control::postprocessing
 {
@@ -61,6 +63,29 @@ struct Trigger {
 
 using TriggerFcn = std::function<Trigger()>;
 
+/// \brief Notifications of the objects received by a post-processing device from the QC workflow.
+///
+/// The device reports the objects of each source (e.g. a Check) as they arrive, the triggers created with
+/// triggers::NewObjectInWorkflow() compare the number of notifications of their source with the one they have seen.
+/// It is not thread-safe.
+class ObjectNotifications
+{
+ public:
+  /// \brief Records that a new object of the source has arrived at the given time (ms since epoch).
+  void notify(const std::string& source, uint64_t timestamp);
+  /// \return the number of notifications of the source so far
+  size_t getCount(const std::string& source) const;
+  /// \return the time of the latest notification of the source, 0 if there was none
+  uint64_t getLastTimestamp(const std::string& source) const;
+
+ private:
+  struct Notification {
+    size_t count = 0;
+    uint64_t timestamp = 0;
+  };
+  std::map<std::string, Notification> mNotifications;
+};
+
 namespace triggers
 {
 
@@ -76,6 +101,9 @@ TriggerFcn EndOfFill();
 TriggerFcn Periodic(double seconds);
 /// \brief Triggers when it detect a new object in QC repository with given name
 TriggerFcn NewObject(std::string databaseUrl, std::string objectPath);
+/// \brief Triggers when a new object of the source is notified, without querying the repository.
+/// Only the notifications which arrive after the trigger is created are taken into account.
+TriggerFcn NewObjectInWorkflow(std::shared_ptr<const ObjectNotifications> notifications, std::string source);
 /// \brief Triggers only first time it is executed
 TriggerFcn Once();
 /// \brief Triggers always
@@ -16,30 +16,46 @@
 #ifndef QC_CHECKER_POLICYMANAGER_H
 #define QC_CHECKER_POLICYMANAGER_H
 
+#include <cstdint>
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
-#include <functional>
 #include <iosfwd>
 
 namespace o2::quality_control::checker
 {
 
-using UpdatePolicyFunctionType = std::function<bool()>;
 typedef uint32_t RevisionType;
 
+enum class UpdatePolicyType {
+  OnAll,
+  OnAnyNonZero,
+  OnEachSeparately,
+  OnGlobalAny,
+  OnAny
+};
+
 /**
  * Represents a policy and all its associated elements.
  */
 struct UpdatePolicy {
   std::string actorName;
-  UpdatePolicyFunctionType isReady;
+  UpdatePolicyType type;
   std::vector<std::string> inputObjects;
   bool allInputObjects;
-  // TODO this line makes me think that lambdas are not enough because we actually need to store a state...
   bool policyHelperFlag; // the purpose might change depending on policy,
   RevisionType revision = 0;
 
+  // The input objects are referred to by their ids in the UpdatePolicyManager, in the same order as inputObjects.
+  std::vector<size_t> inputObjectsIds;
+  // Marks the inputs which were updated since the last revision of the actor.
+  std::vector<bool> updatedInputs;
+  size_t updatedInputsCount = 0;
+  // Number of inputs which were received at least once.
+  size_t receivedInputsCount = 0;
+
+  bool isReady();
+
   friend std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy); // output
 };
 
@@ -57,6 +73,10 @@ struct UpdatePolicy {
  *   - a revision is a number associated to each object to determine when it was received and associated to
  *     each actor to determine when it was last time triggered.
  *
+ * Object names are given integer ids when they are first seen, their revisions are kept in a vector indexed by the
+ * ids. Each policy keeps track of which of its inputs were updated since the last revision of its actor, so that
+ * checking whether an actor is ready does not require to look up and compare the revisions of all its inputs.
+ *
  * The following policies are available:
  *   - OnAny: triggers when an object is received that matches ANY object listed as a data source of the policy.
  *   - OnAnyNonZero: triggers only if all objects have been received at least once, then trigger the same way as onAny.
@@ -127,9 +147,18 @@ class UpdatePolicyManager
   bool isReady(const std::string& actorName);
 
  private:
-  std::map<std::string /* Actor name */, UpdatePolicy> mPoliciesByActor;
+  size_t getObjectId(const std::string& objectName);
+  UpdatePolicy& getPolicy(const std::string& actorName);
+  static void markUpdatedInputs(UpdatePolicy& policy, const std::vector<RevisionType>& objectsRevision);
+
+  std::vector<UpdatePolicy> mPolicies;
+  std::unordered_map<std::string /* Actor name */, size_t> mPoliciesIndex;
   RevisionType mGlobalRevision = 1;
-  std::map<std::string /* Object name */, RevisionType> mObjectsRevision;
+  std::unordered_map<std::string /* Object name */, size_t> mObjectsIds;
+  std::vector<RevisionType> mObjectsRevision; // indexed by object id, 0 means never received
+  std::vector<bool> mObjectsReceived;         // indexed by object id
+  // for each object id, the policies (index, input position) having it as input
+  std::vector<std::vector<std::pair<size_t, size_t>>> mObjectsSubscribers;
 };
 
 } // namespace o2::quality_control::checker
@@ -113,6 +113,7 @@ void AggregatorRunner::init(framework::InitContext& iCtx)
 void AggregatorRunner::run(framework::ProcessingContext& ctx)
 {
   framework::InputRecord& inputs = ctx.inputs();
+  std::vector<shared_ptr<const QualityObject>> receivedQOs;
   for (auto const& ref : InputRecordWalker(inputs)) { // InputRecordWalker because the output of CheckRunner can be multi-part
     ILOG(Debug, Trace) << "AggregatorRunner received data" << ENDM;
     shared_ptr<const QualityObject> qo = inputs.get<QualityObject*>(ref);
@@ -121,13 +122,25 @@ void AggregatorRunner::run(framework::ProcessingContext& ctx)
       mQualityObjects[qo->getName()] = qo;
       mTotalNumberObjectsReceived++;
       updatePolicyManager.updateObjectRevision(qo->getName());
+      receivedQOs.push_back(qo);
     }
   }
 
   auto qualityObjects = aggregate();
   store(qualityObjects);
 
+  if (!qualityObjects.empty()) {
+    auto storageTime = latency_tracing::now();
+    for (const auto& qo : receivedQOs) {
+      if (auto latency = latency_tracing::getSecondsSince(qo->getMetadataMap(), latency_tracing::cycleEndKey, storageTime)) {
+        mAggregationLatency.add(*latency);
+      }
+    }
+  }
+
   updatePolicyManager.updateGlobalRevision();
+
+  sendPeriodicMonitoring();
 }
 
 QualityObjectsType AggregatorRunner::aggregate()
@@ -179,7 +192,7 @@ void AggregatorRunner::initDatabase()
   mDatabase->connect(mConfigFile->getRecursiveMap("qc.config.database"));
   ILOG(Info, Devel) << "Database that is going to be used : ";
   ILOG(Info, Devel) << ">> Implementation : " << mConfigFile->get<std::string>("qc.config.database.implementation");
-  ILOG(Info, Devel) << ">> Host : " << mConfigFile->get<std::string>("qc.config.database.host");
+  ILOG(Info, Devel) << ">> Host : " << mConfigFile->get<std::string>("qc.config.database.host", "");
 }
 
 void AggregatorRunner::initMonitoring()
@@ -189,7 +202,7 @@ void AggregatorRunner::initMonitoring()
   mCollector->enableProcessMonitoring();
   mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
   mCollector->addGlobalTag("AggregatorRunnerName", mDeviceName);
-  mTimer.reset(1000000); // 10 s.
+  mTimer.reset(10000000); // 10 s.
 }
 
 void AggregatorRunner::initServiceDiscovery()
@@ -301,8 +314,14 @@ void AggregatorRunner::reorderAggregators()
 void AggregatorRunner::sendPeriodicMonitoring()
 {
   if (mTimer.isTimeout()) {
-    mTimer.reset(1000000); // 10 s.
+    mTimer.reset(10000000); // 10 s.
     mCollector->send({ mTotalNumberObjectsReceived, "qc_objects_received" }, DerivedMetricMode::RATE);
+    if (!mAggregationLatency.empty()) {
+      mCollector->send(Metric{ "qc_aggregation_latency" }
+                         .addValue(mAggregationLatency.getQuantile(0.5), "p50")
+                         .addValue(mAggregationLatency.getQuantile(0.99), "p99"));
+      mAggregationLatency.reset();
+    }
   }
 }
 
@@ -42,6 +42,18 @@ size_t numberOfMergerLayers(size_t M0, size_t R)
   return std::ceil(std::log((double)M0) / std::log((double)R));
 }
 
+// number of mergers in each layer, M0 is number of producers, R >= 2 is max reduction factor. The last layer has one merger.
+std::vector<size_t> mergersPerLayer(size_t M0, size_t R)
+{
+  std::vector<size_t> mergers;
+  size_t Mi = M0;
+  do {
+    Mi = std::ceil(Mi / (double)R);
+    mergers.push_back(Mi);
+  } while (Mi > 1);
+  return mergers;
+}
+
 double mergersMemoryUsage(size_t R, size_t M0, size_t objSize, double T, std::function<double(double)> performance)
 {
   const size_t layers = numberOfMergerLayers(M0, R);
@@ -51,7 +63,7 @@ double mergersMemoryUsage(size_t R, size_t M0, size_t objSize, double T, std::fu
 
   for (size_t layer = 1; layer <= layers; layer++) {
     const size_t Mi_prev = Mi;
-    const size_t Mi = std::ceil(Mi_prev / (double)R);
+    Mi = std::ceil(Mi_prev / (double)R);
     const double Ri = Mi_prev / (double)Mi;
     const double rho = Ri / (double)T / performance(Ri);
 
@@ -76,7 +88,7 @@ double mergersCpuUsage(size_t R, size_t M0, double T, std::function<double(doubl
   size_t Mi = M0;
   for (size_t layer = 1; layer <= layers; layer++) {
     const size_t Mi_prev = Mi;
-    const size_t Mi = std::ceil(Mi_prev / (double)R);
+    Mi = std::ceil(Mi_prev / (double)R);
     const double Ri = Mi_prev / (double)Mi;
     const double rho = Ri / (double)T / performance(Ri);
 
@@ -21,6 +21,7 @@
 // O2
 #include <CommonUtils/MemFileHelper.h>
 // ROOT
+#include <TBufferFile.h>
 #include <TBufferJSON.h>
 #include <TH1F.h>
 #include <TFile.h>
@@ -31,6 +32,7 @@
 #include <TSystem.h>
 // std
 #include <chrono>
+#include <future>
 #include <sstream>
 #include <unordered_set>
 // boost
@@ -99,6 +101,13 @@ void CcdbDatabase::connect(std::string host, std::string /*database*/, std::stri
 void CcdbDatabase::connect(const std::unordered_map<std::string, std::string>& config)
 {
   mUrl = config.at("host");
+  if (auto size = config.find("retrievalCacheSize"); size != config.end() && !size->second.empty() && std::stoul(size->second) > 0) {
+    mRetrievalCache = std::make_unique<RetrievalCache>(std::stoul(size->second) * 1024 * 1024);
+    ILOG(Info, Support) << "Objects retrieved from the CCDB are cached, up to " << size->second << " MB" << ENDM;
+  }
+  if (auto threads = config.find("retrievalThreads"); threads != config.end() && !threads->second.empty()) {
+    mRetrievalThreads = std::stoul(threads->second);
+  }
   init();
 }
 
@@ -106,6 +115,19 @@ void CcdbDatabase::init()
 {
   ccdbApi.init(mUrl);
   loadDeprecatedStreamerInfos();
+
+  mRetrievalApis.clear();
+  mRetrievalPool.reset();
+  if (mRetrievalThreads > 1) {
+    // the objects are deserialized concurrently
+    ROOT::EnableThreadSafety();
+    for (size_t i = 0; i < mRetrievalThreads; i++) {
+      mRetrievalApis.emplace_back(std::make_unique<o2::ccdb::CcdbApi>());
+      mRetrievalApis.back()->init(mUrl);
+    }
+    mRetrievalPool = std::make_unique<ThreadPool>(mRetrievalThreads);
+    ILOG(Info, Support) << "Objects are retrieved in batches with up to " << mRetrievalThreads << " concurrent connections" << ENDM;
+  }
 }
 
 void CcdbDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
@@ -214,22 +236,156 @@ void CcdbDatabase::storeQO(std::shared_ptr<const o2::quality_control::core::Qual
   ccdbApi.storeAsTFileAny<QualityObject>(qo.get(), path, metadata, from, to);
 }
 
-TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
+namespace
+{
+TObject* cloneDetached(const TObject* object)
+{
+  auto* clone = object->Clone();
+  if (auto* histogram = dynamic_cast<TH1*>(clone)) {
+    histogram->SetDirectory(nullptr);
+  }
+  return clone;
+}
+
+long getHeaderAsLong(const std::map<std::string, std::string>& headers, const std::string& name, long defaultValue)
+{
+  auto header = headers.find(name);
+  if (header == headers.end() || header->second.empty()) {
+    return defaultValue;
+  }
+  try {
+    return std::stol(header->second);
+  } catch (const std::logic_error&) {
+    return defaultValue;
+  }
+}
+} // namespace
+
+TObject* CcdbDatabase::retrieveCachedTObject(o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>& headers)
+{
+  if (timestamp < 0) {
+    timestamp = getCurrentTimestamp();
+  }
+  std::string etag;
+  {
+    std::lock_guard<std::mutex> lock(mRetrievalCacheMutex);
+    if (const auto* cached = mRetrievalCache->find(path, metadata, timestamp)) {
+      etag = cached->etag;
+    }
+  }
+  // the server answers "not modified" without any object if the version to return still has the cached ETag
+  auto* object = api.retrieveFromTFileAny<TObject>(path, metadata, timestamp, &headers, etag);
+  if (object == nullptr && !etag.empty() && headers.count("ETag") > 0 && headers.at("ETag") == etag) {
+    {
+      std::lock_guard<std::mutex> lock(mRetrievalCacheMutex);
+      const auto* cached = mRetrievalCache->find(path, metadata, timestamp);
+      if (cached != nullptr && cached->etag == etag) {
+        mRetrievalCache->recordHit();
+        headers = cached->headers;
+        return cloneDetached(cached->object.get());
+      }
+    }
+    // evicted by a concurrent retrieval in the meantime
+    headers.clear();
+    object = api.retrieveFromTFileAny<TObject>(path, metadata, timestamp, &headers);
+  }
+  std::lock_guard<std::mutex> lock(mRetrievalCacheMutex);
+  mRetrievalCache->recordMiss();
+  if (object == nullptr) {
+    return nullptr;
+  }
+
+  auto entry = std::make_unique<RetrievalCache::Entry>();
+  entry->headers = headers;
+  // Content-MD5 identifies the version as well, if the server does not provide any ETag
+  entry->etag = headers.count("ETag") > 0 ? headers.at("ETag") : (headers.count("Content-MD5") > 0 ? headers.at("Content-MD5") : "");
+  entry->validFrom = getHeaderAsLong(headers, "Valid-From", timestamp);
+  entry->validUntil = getHeaderAsLong(headers, "Valid-Until", timestamp + 1);
+  if (entry->etag.empty() || entry->validFrom > timestamp || entry->validUntil <= timestamp) {
+    return object;
+  }
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(object);
+  entry->bytes = buffer.Length();
+  entry->object.reset(cloneDetached(object));
+  mRetrievalCache->insert(path, metadata, std::move(entry));
+  return object;
+}
+
+TObject* CcdbDatabase::retrieveTObject(o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers)
 {
   // we try first to load a TFile
-  auto* object = ccdbApi.retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  TObject* object = nullptr;
+  if (mRetrievalCache) {
+    std::map<std::string, std::string> responseHeaders;
+    object = retrieveCachedTObject(api, path, metadata, timestamp, responseHeaders);
+    if (headers) {
+      *headers = std::move(responseHeaders);
+    }
+  } else {
+    object = api.retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  }
   if (object == nullptr) {
     // We could not open a TFile we should now try to open an object directly serialized
-    object = ccdbApi.retrieve(path, metadata, timestamp);
-    if (object == nullptr) {
-      ILOG(Error, Support) << "We could NOT retrieve the object " << path << "." << ENDM;
-      return nullptr;
-    }
+    object = api.retrieve(path, metadata, timestamp);
+  }
+  return object;
+}
+
+TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  auto* object = retrieveTObject(ccdbApi, path, metadata, timestamp, headers);
+  if (object == nullptr) {
+    ILOG(Error, Support) << "We could NOT retrieve the object " << path << "." << ENDM;
+    return nullptr;
   }
   ILOG(Debug, Support) << "Retrieved object " << path << " with timestamp " << timestamp << ENDM;
   return object;
 }
 
+std::vector<DatabaseInterface::RetrievedObject> CcdbDatabase::retrieveMany(const std::vector<RetrievalRequest>& requests)
+{
+  if (mRetrievalPool == nullptr || requests.size() < 2) {
+    return DatabaseInterface::retrieveMany(requests);
+  }
+
+  // each worker uses its own connection and takes every n-th request, so that the slow ones are spread
+  std::vector<RetrievedObject> results(requests.size());
+  const size_t workers = std::min(mRetrievalApis.size(), requests.size());
+  std::vector<std::future<void>> futures;
+  futures.reserve(workers);
+  for (size_t worker = 0; worker < workers; worker++) {
+    futures.emplace_back(mRetrievalPool->submit([&, worker]() {
+      for (size_t i = worker; i < requests.size(); i += workers) {
+        const auto& request = requests[i];
+        results[i].object.reset(retrieveTObject(*mRetrievalApis[worker], request.path, request.metadata, request.timestamp, &results[i].headers));
+      }
+    }));
+  }
+  std::exception_ptr failure;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!failure) {
+        failure = std::current_exception();
+      }
+    }
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+
+  // InfoLogger is not used by the workers, since it is not thread-safe
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (results[i].object == nullptr) {
+      ILOG(Error, Support) << "We could NOT retrieve the object " << requests[i].path << "." << ENDM;
+    }
+  }
+  ILOG(Debug, Support) << "Retrieved " << requests.size() << " objects with " << workers << " connections" << ENDM;
+  return results;
+}
+
 void* CcdbDatabase::retrieveAny(const type_info& tinfo, const string& path, const map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers, const string& createdNotAfter, const string& createdNotBefore)
 {
   auto* object = ccdbApi.retrieveFromTFile(tinfo, path, metadata, timestamp, headers, "", createdNotAfter, createdNotBefore);
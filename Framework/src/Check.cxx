@@ -13,8 +13,7 @@
 #include <memory>
 #include <algorithm>
 // boost
-#include <boost/range/adaptor/map.hpp>
-#include <boost/range/algorithm/copy.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 // ROOT
 #include <TClass.h>
 // O2
@@ -26,6 +25,7 @@
 #include "QualityControl/InputUtils.h"
 #include "QualityControl/RootClassFactory.h"
 #include "QualityControl/PostProcessingDevice.h"
+#include "QualityControl/LatencyTracing.h"
 // Fairlogger
 #include <fairlogger/Logger.h>
 
@@ -173,69 +173,84 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
   }
 
-  std::map<std::string, std::shared_ptr<MonitorObject>> shadowMap;
+  mObjectsToCheck.clear();
   // Take only the MOs which are needed to be checked
   if (mCheckConfig.allObjects) {
     /*
      * User didn't specify the MOs.
      * All MOs are passed, no shadowing needed.
      */
-    shadowMap = moMap;
+    for (const auto& entry : moMap) {
+      mObjectsToCheck.push_back(&entry);
+    }
   } else {
     /*
      * Shadow MOs.
      * Don't pass MOs that weren't specified by user.
-     * The user might safely rely on getting only required MOs inside the map.
+     * The user might safely rely on getting only required MOs inside the view.
      *
-     * Implementation: Copy to different map only required MOs.
+     * Implementation: refer only to the required entries of moMap, in the order of the map.
      */
-    for (auto& key : mCheckConfig.objectNames) {
-      // don't create empty shared_ptr
-      if (moMap.count(key)) {
-        shadowMap.insert({ key, moMap[key] });
+    for (const auto& key : mCheckConfig.objectNames) {
+      if (auto entry = moMap.find(key); entry != moMap.end()) {
+        mObjectsToCheck.push_back(&*entry);
       }
     }
+    std::sort(mObjectsToCheck.begin(), mObjectsToCheck.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
   }
 
-  // Prepare a vector of MO maps to be checked, each one will receive a separate Quality.
-  std::vector<std::map<std::string, std::shared_ptr<MonitorObject>>> moMapsToCheck;
+  QualityObjectsType qualityObjects;
   if (mCheckConfig.policyType == "OnEachSeparately") {
     // In this case we want to check all MOs separately and we get separate QOs for them.
-    for (auto mo : shadowMap) {
-      moMapsToCheck.push_back({ std::move(mo) });
+    qualityObjects.reserve(mObjectsToCheck.size());
+    for (size_t i = 0; i < mObjectsToCheck.size(); i++) {
+      qualityObjects.emplace_back(check(MonitorObjectsView(mObjectsToCheck.data() + i, 1)));
     }
   } else {
-    moMapsToCheck.emplace_back(shadowMap);
+    qualityObjects.emplace_back(check(MonitorObjectsView(mObjectsToCheck.data(), mObjectsToCheck.size())));
   }
 
-  QualityObjectsType qualityObjects;
-  for (auto& moMapToCheck : moMapsToCheck) {
-    std::vector<std::string> monitorObjectsNames;
-    boost::copy(moMapToCheck | boost::adaptors::map_keys, std::back_inserter(monitorObjectsNames));
+  return qualityObjects;
+}
 
-    auto quality = mCheckInterface->check(&moMapToCheck);
-    mLogger << "Check '" << mCheckConfig.name << "', quality '" << quality << "'" << ENDM;
-    // todo: take metadata from somewhere
-    qualityObjects.emplace_back(std::make_shared<QualityObject>(
-      quality,
-      mCheckConfig.name,
-      mCheckConfig.detectorName,
-      mCheckConfig.policyType,
-      mInputsStringified,
-      monitorObjectsNames));
-    beautify(moMapToCheck, quality);
+std::shared_ptr<QualityObject> Check::check(const MonitorObjectsView& moView)
+{
+  std::vector<std::string> monitorObjectsNames;
+  monitorObjectsNames.reserve(moView.size());
+  const MonitorObject* latestMO = nullptr;
+  for (const auto& entry : moView) {
+    monitorObjectsNames.push_back(entry.first);
+    if (entry.second && (latestMO == nullptr || latency_tracing::isPublishedLater(entry.second->getMetadataMap(), latestMO->getMetadataMap()))) {
+      latestMO = entry.second.get();
+    }
   }
 
-  return qualityObjects;
+  // the result is logged by the caller, this method might be invoked in a thread other than the main one
+  auto quality = mCheckInterface->checkView(moView);
+  // todo: take metadata from somewhere
+  auto qualityObject = std::make_shared<QualityObject>(
+    quality,
+    mCheckConfig.name,
+    mCheckConfig.detectorName,
+    mCheckConfig.policyType,
+    mInputsStringified,
+    monitorObjectsNames);
+  // the QO traces the latency of the most recent data it was given
+  if (latestMO != nullptr) {
+    qualityObject->addMetadata(latency_tracing::getTaskMetadata(latestMO->getMetadataMap()));
+  }
+  qualityObject->addMetadata(latency_tracing::checkKey, std::to_string(latency_tracing::now()));
+  beautify(moView, quality);
+  return qualityObject;
 }
 
-void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, Quality quality)
+void Check::beautify(const MonitorObjectsView& moView, Quality quality)
 {
   if (!mBeautify) {
     return;
   }
 
-  for (auto const& item : moMap) {
+  for (auto const& item : moView) {
     mCheckInterface->beautify(item.second /*mo*/, quality);
   }
 }
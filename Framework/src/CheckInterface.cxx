@@ -6,6 +6,7 @@
 #include "QualityControl/CheckInterface.h"
 
 #include <TClass.h>
+#include <vector>
 
 ClassImp(o2::quality_control::checker::CheckInterface)
 
@@ -14,6 +15,22 @@ ClassImp(o2::quality_control::checker::CheckInterface)
 namespace o2::quality_control::checker
 {
 
+Quality CheckInterface::checkView(const MonitorObjectsView& moView)
+{
+  auto moMap = moView.toMap();
+  return check(&moMap);
+}
+
+Quality CheckInterface::checkMapThroughView(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap)
+{
+  std::vector<const MonitorObjectsView::value_type*> entries;
+  entries.reserve(moMap->size());
+  for (const auto& entry : *moMap) {
+    entries.push_back(&entry);
+  }
+  return checkView(MonitorObjectsView(entries.data(), entries.size()));
+}
+
 std::string CheckInterface::getAcceptedType() { return "TObject"; }
 
 bool CheckInterface::isObjectCheckable(const std::shared_ptr<MonitorObject> mo)
@@ -17,6 +17,9 @@
 
 #include "QualityControl/CheckRunner.h"
 
+// std
+#include <algorithm>
+#include <exception>
 // O2
 #include <Common/Exceptions.h>
 #include <Configuration/ConfigurationFactory.h>
@@ -29,6 +32,8 @@
 #include "QualityControl/ServiceDiscovery.h"
 // Fairlogger
 #include <fairlogger/Logger.h>
+// ROOT
+#include <TROOT.h>
 
 using namespace std::chrono;
 using namespace AliceO2::Common;
@@ -191,6 +196,7 @@ void CheckRunner::init(framework::InitContext& iCtx)
       check.init();
       updatePolicyManager.addPolicy(check.getName(), check.getPolicyName(), check.getObjectsNames(), check.getAllObjectsOption(), false);
     }
+    initCheckPool();
   } catch (...) {
     // catch the exceptions and print it (the ultimate caller might not know how to display it)
     ILOG(Fatal, Ops) << "Unexpected exception during initialization:\n"
@@ -203,7 +209,12 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
 {
   prepareCacheData(ctx.inputs());
 
+  AliceO2::Common::Timer checkTimer;
   auto qualityObjects = check();
+  double checkDuration = checkTimer.getTime();
+  mCheckDurationInPeriod += checkDuration;
+  mMaxCheckDurationInPeriod = std::max(mMaxCheckDurationInPeriod, checkDuration);
+  mNumberOfCheckCallsInPeriod++;
 
   store(qualityObjects);
   store(mMonitorObjectStoreVector);
@@ -219,6 +230,7 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
 void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
 {
   mMonitorObjectStoreVector.clear();
+  auto receptionTime = latency_tracing::now();
 
   for (const auto& input : mInputs) {
     auto dataRef = inputRecord.get(input.binding.c_str());
@@ -226,20 +238,20 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
 
       // We don't know what we receive, so we test for an array and then try a tobject.
       // If we received a tobject, it gets encapsulated in the tobjarray.
-      shared_ptr<const TObjArray> array = nullptr;
-      shared_ptr<const TObject> tobj = inputRecord.get<TObject*>(input.binding.c_str());
-      // if the object has not been found, it will raise an exception that we just let go.
+      // The object is deserialized only once, from the DataRef we already have, and we take over its ownership
+      // instead of copying it. If the object has not been found, it will raise an exception that we just let go.
+      TObject* tobj = const_cast<TObject*>(inputRecord.get<TObject*>(dataRef).release());
+      std::unique_ptr<TObjArray> array;
       if (tobj->InheritsFrom("TObjArray")) {
-        array = dynamic_pointer_cast<const TObjArray>(tobj);
+        array.reset(static_cast<TObjArray*>(tobj));
         mLogger << AliceO2::InfoLogger::InfoLogger::Info << "CheckRunner " << mDeviceName
                 << " received an array with " << array->GetEntries()
                 << " entries from " << input.binding << ENDM;
       } else {
         // it is just a TObject not embedded in a TObjArray. We build a TObjArray for it.
-        auto* newArray = new TObjArray();    // we cannot use `array` to add an object as it is const
-        TObject* newTObject = tobj->Clone(); // we need a copy to avoid that it gets deleted behind our back.
-        newArray->Add(newTObject);
-        array.reset(newArray); // now that the array is ready we can adopt it.
+        // The array does not own it, it is adopted by the MonitorObject below.
+        array = std::make_unique<TObjArray>();
+        array->Add(tobj);
         mLogger << AliceO2::InfoLogger::InfoLogger::Info << "CheckRunner " << mDeviceName
                 << " received a tobject named " << tobj->GetName()
                 << " from " << input.binding << ENDM;
@@ -263,6 +275,9 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
           mMonitorObjects[mo->getFullName()] = mo;
           updatePolicyManager.updateObjectRevision(mo->getFullName());
           mTotalNumberObjectsReceived++;
+          if (auto latency = latency_tracing::getSecondsSince(mo->getMetadataMap(), latency_tracing::publicationKey, receptionTime)) {
+            mReceptionLatency.add(*latency);
+          }
 
           if (store) { // Monitor Object will be stored later, after possible beautification
             mMonitorObjectStoreVector.push_back(mo);
@@ -279,6 +294,42 @@ void CheckRunner::sendPeriodicMonitoring()
     mTimer.reset(10000000); // 10 s.
     mCollector->send({ mTotalNumberObjectsReceived, "qc_objects_received" }, DerivedMetricMode::RATE);
     mCollector->send({ mTotalNumberCheckExecuted, "qc_checks_executed" }, DerivedMetricMode::RATE);
+    if (mNumberOfCheckCallsInPeriod > 0) {
+      mCollector->send(Metric{ "qc_checks_duration" }
+                         .addValue(mCheckDurationInPeriod / mNumberOfCheckCallsInPeriod, "average")
+                         .addValue(mMaxCheckDurationInPeriod, "max"));
+      mCheckDurationInPeriod = 0;
+      mMaxCheckDurationInPeriod = 0;
+      mNumberOfCheckCallsInPeriod = 0;
+    }
+    if (!mReceptionLatency.empty()) {
+      mCollector->send(Metric{ "qc_mo_reception_latency" }
+                         .addValue(mReceptionLatency.getQuantile(0.5), "p50")
+                         .addValue(mReceptionLatency.getQuantile(0.99), "p99"));
+      mReceptionLatency.reset();
+    }
+    if (mStorageQueue) {
+      // the QOs are stored by the workers of the queue, which measure the latency when they are done
+      mStorageLatency = mStorageQueue->popStorageLatency();
+    }
+    if (!mStorageLatency.empty()) {
+      mCollector->send(Metric{ "qc_qo_storage_latency" }
+                         .addValue(mStorageLatency.getQuantile(0.5), "p50")
+                         .addValue(mStorageLatency.getQuantile(0.99), "p99"));
+      mStorageLatency.reset();
+    }
+    if (mStorageQueue) {
+      auto statistics = mStorageQueue->getStatistics();
+      mTotalNumberQOStored = static_cast<int>(statistics.storedQOs);
+      mTotalNumberMOStored = static_cast<int>(statistics.storedMOs);
+      mCollector->send({ static_cast<int>(statistics.coalesced), "qc_storage_coalesced" }, DerivedMetricMode::RATE);
+      mCollector->send({ static_cast<int>(statistics.dropped), "qc_storage_dropped" }, DerivedMetricMode::RATE);
+      mCollector->send({ static_cast<int>(statistics.failed), "qc_storage_failed" }, DerivedMetricMode::RATE);
+      mCollector->send({ static_cast<int>(statistics.pending), "qc_storage_pending" });
+      if (auto error = mStorageQueue->popLastError(); !error.empty()) {
+        ILOG(Error, Support) << "Unable to store objects in the repository, last error: " << error << ENDM;
+      }
+    }
     mCollector->send({ mTotalNumberQOStored, "qc_qo_stored" }, DerivedMetricMode::RATE);
     mCollector->send({ mTotalNumberMOStored, "qc_mo_stored" }, DerivedMetricMode::RATE);
   }
@@ -289,20 +340,59 @@ QualityObjectsType CheckRunner::check()
   mLogger << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
           << ENDM;
 
-  QualityObjectsType allQOs;
-  for (auto& check : mChecks) {
-    if (updatePolicyManager.isReady(check.getName())) {
-      auto newQOs = check.check(mMonitorObjects);
-      mTotalNumberCheckExecuted += newQOs.size();
+  std::vector<size_t> readyChecks;
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    if (updatePolicyManager.isReady(mChecks[i].getName())) {
+      readyChecks.push_back(i);
+    } else {
+      mLogger << "Monitor Objects for the check '" << mChecks[i].getName() << "' are not ready, ignoring" << ENDM;
+    }
+  }
 
-      allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
-      newQOs.clear();
+  // the results are kept in the order of the checks, so that they do not depend on the execution order
+  std::vector<QualityObjectsType> results(mChecks.size());
+  if (mCheckPool && readyChecks.size() > 1) {
+    std::vector<std::future<void>> executions;
+    executions.reserve(readyChecks.size());
+    for (auto i : readyChecks) {
+      executions.emplace_back(mCheckPool->submit([this, i, &results]() {
+        std::lock_guard<std::mutex> guard(*mCheckGuards[i]);
+        results[i] = mChecks[i].check(mMonitorObjects);
+      }));
+    }
+    // all the checks have to be finished before we let any exception go, they use the cache and the results
+    std::exception_ptr firstError;
+    for (auto& execution : executions) {
+      try {
+        execution.get();
+      } catch (...) {
+        if (!firstError) {
+          firstError = std::current_exception();
+        }
+      }
+    }
+    if (firstError) {
+      std::rethrow_exception(firstError);
+    }
+  } else {
+    for (auto i : readyChecks) {
+      results[i] = mChecks[i].check(mMonitorObjects);
+    }
+  }
 
-      // Was checked, update latest revision
-      updatePolicyManager.updateActorRevision(check.getName());
-    } else {
-      mLogger << "Monitor Objects for the check '" << check.getName() << "' are not ready, ignoring" << ENDM;
+  QualityObjectsType allQOs;
+  for (auto i : readyChecks) {
+    auto& newQOs = results[i];
+    for (const auto& qo : newQOs) {
+      mLogger << "Check '" << mChecks[i].getName() << "', quality '" << qo->getQuality() << "'" << ENDM;
     }
+    mTotalNumberCheckExecuted += newQOs.size();
+
+    allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
+    newQOs.clear();
+
+    // Was checked, update latest revision
+    updatePolicyManager.updateActorRevision(mChecks[i].getName());
   }
   return allQOs;
 }
@@ -310,10 +400,19 @@ QualityObjectsType CheckRunner::check()
 void CheckRunner::store(QualityObjectsType& qualityObjects)
 {
   mLogger << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
+  if (mStorageQueue) {
+    for (auto& qo : qualityObjects) {
+      mStorageQueue->push(qo);
+    }
+    return;
+  }
   try {
     for (auto& qo : qualityObjects) {
       mDatabase->storeQO(qo);
       mTotalNumberQOStored++;
+      if (auto latency = latency_tracing::getSecondsSince(qo->getMetadataMap(), latency_tracing::cycleEndKey)) {
+        mStorageLatency.add(*latency);
+      }
     }
   } catch (boost::exception& e) {
     mLogger << "Unable to " << diagnostic_information(e) << ENDM;
@@ -323,6 +422,16 @@ void CheckRunner::store(QualityObjectsType& qualityObjects)
 void CheckRunner::store(std::vector<std::shared_ptr<MonitorObject>>& monitorObjects)
 {
   mLogger << "Storing " << monitorObjects.size() << " MonitorObjects" << ENDM;
+  if (mStorageQueue) {
+    // The MOs are stored after the beautification of this cycle, but the instances in the cache can still be modified
+    // by the next beautify() while a worker streams them. The queue gets its own copy, which nobody modifies anymore.
+    for (auto& mo : monitorObjects) {
+      std::shared_ptr<MonitorObject> snapshot{ dynamic_cast<MonitorObject*>(mo->Clone()) };
+      snapshot->setIsOwner(true);
+      mStorageQueue->push(snapshot);
+    }
+    return;
+  }
   try {
     for (auto& mo : monitorObjects) {
       mDatabase->storeMO(mo);
@@ -389,7 +498,75 @@ void CheckRunner::initDatabase()
   mDatabase->connect(mConfigFile->getRecursiveMap("qc.config.database"));
   ILOG(Info, Support) << "Database that is going to be used : " << ENDM;
   ILOG(Info, Support) << ">> Implementation : " << mConfigFile->get<std::string>("qc.config.database.implementation") << ENDM;
-  ILOG(Info, Support) << ">> Host : " << mConfigFile->get<std::string>("qc.config.database.host") << ENDM;
+  ILOG(Info, Support) << ">> Host : " << mConfigFile->get<std::string>("qc.config.database.host", "") << ENDM;
+
+  StorageQueue::Config queueConfig;
+  queueConfig.threads = mConfigFile->get<size_t>("qc.config.checkRunner.storageThreads", 0);
+  if (queueConfig.threads > 0) {
+    queueConfig.capacity = mConfigFile->get<size_t>("qc.config.checkRunner.storageQueueSize", queueConfig.capacity);
+    queueConfig.batchSize = mConfigFile->get<size_t>("qc.config.checkRunner.storageBatchSize", queueConfig.batchSize);
+    auto implementation = mConfigFile->get<std::string>("qc.config.database.implementation");
+    auto databaseConfig = mConfigFile->getRecursiveMap("qc.config.database");
+    // the objects are streamed by the workers while this thread keeps using ROOT
+    ROOT::EnableThreadSafety();
+    // each worker gets its own connection, so that the database implementations do not have to be thread-safe
+    mStorageQueue = std::make_unique<StorageQueue>(
+      [implementation, databaseConfig]() {
+        auto database = DatabaseFactory::create(implementation);
+        database->connect(databaseConfig);
+        return database;
+      },
+      queueConfig);
+    ILOG(Info, Support) << ">> Objects are stored asynchronously by " << queueConfig.threads << " thread(s), queue size "
+                        << queueConfig.capacity << ENDM;
+  }
+}
+
+void CheckRunner::initCheckPool()
+{
+  auto threads = mConfigFile->get<size_t>("qc.config.checkRunner.threads", 0);
+  if (threads <= 1 || mChecks.size() <= 1) {
+    return;
+  }
+
+  // Checks which might access the same objects cannot run at the same time, because beautify() modifies them.
+  // Such Checks share the same guard, the others get their own one.
+  auto shareObjects = [](const Check& a, const Check& b) {
+    if (a.getAllObjectsOption() || b.getAllObjectsOption()) {
+      return true;
+    }
+    const auto namesA = a.getObjectsNames();
+    const auto namesB = b.getObjectsNames();
+    return std::any_of(namesA.begin(), namesA.end(), [&](const auto& name) {
+      return std::find(namesB.begin(), namesB.end(), name) != namesB.end();
+    });
+  };
+  // Checks are grouped transitively, each group gets one guard.
+  std::vector<size_t> group(mChecks.size());
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    group[i] = i;
+    for (size_t j = 0; j < i; j++) {
+      if (group[j] != group[i] && shareObjects(mChecks[i], mChecks[j])) {
+        const size_t merged = group[i], into = group[j];
+        std::replace(group.begin(), group.begin() + i + 1, merged, into);
+      }
+    }
+  }
+  std::vector<std::shared_ptr<std::mutex>> groupGuards(mChecks.size());
+  mCheckGuards.clear();
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    auto& guard = groupGuards[group[i]];
+    if (guard == nullptr) {
+      guard = std::make_shared<std::mutex>();
+    }
+    mCheckGuards.push_back(guard);
+  }
+
+  // the Checks use ROOT from several threads. The InfoLogger is not thread-safe though, this is documented for users.
+  ROOT::EnableThreadSafety();
+  mCheckPool = std::make_unique<ThreadPool>(std::min(threads, mChecks.size()));
+  ILOG(Info, Support) << "Checks are run by " << mCheckPool->size() << " threads" << ENDM;
+  ILOG(Warning, Support) << "Checks running concurrently must not log with ILOG nor draw, they are not thread-safe" << ENDM;
 }
 
 void CheckRunner::initMonitoring()
@@ -405,6 +582,10 @@ void CheckRunner::initMonitoring()
 void CheckRunner::initServiceDiscovery()
 {
   auto consulUrl = mConfigFile->get<std::string>("qc.config.consul.url", "http://consul-test.cern.ch:8500");
+  if (consulUrl.empty()) {
+    ILOG(Warning, Support) << "Service Discovery disabled" << ENDM;
+    return;
+  }
   std::string url = ServiceDiscovery::GetDefaultUrl(ServiceDiscovery::DefaultHealthPort + 1); // we try to avoid colliding with the TaskRunner
   mServiceDiscovery = std::make_shared<ServiceDiscovery>(consulUrl, mDeviceName, mDeviceName, url);
   ILOG(Info, Support) << "ServiceDiscovery initialized" << ENDM;
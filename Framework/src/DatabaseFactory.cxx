@@ -19,6 +19,7 @@
 #include <Common/Exceptions.h>
 // QC
 #include "QualityControl/DummyDatabase.h"
+#include "QualityControl/LocalDatabase.h"
 #include "QualityControl/DatabaseFactory.h"
 #include "QualityControl/QcInfoLogger.h"
 #ifdef _WITH_MYSQL
@@ -49,6 +50,9 @@ std::unique_ptr<DatabaseInterface> DatabaseFactory::create(std::string name)
   } else if (name == "Dummy") {
     QcInfoLogger::GetInstance() << "Dummy backend selected, MonitorObjects will not be stored nor retrieved" << QcInfoLogger::endm;
     return std::make_unique<DummyDatabase>();
+  } else if (name == "Local") {
+    QcInfoLogger::GetInstance() << "Local backend selected" << QcInfoLogger::endm;
+    return std::make_unique<LocalDatabase>();
   } else {
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("No database named " + name));
   }
@@ -0,0 +1,61 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseInterface.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/DatabaseInterface.h"
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+std::vector<DatabaseInterface::RetrievedObject> DatabaseInterface::retrieveMany(const std::vector<RetrievalRequest>& requests)
+{
+  std::vector<RetrievedObject> results(requests.size());
+  for (size_t i = 0; i < requests.size(); i++) {
+    results[i].object.reset(retrieveTObject(requests[i].path, requests[i].metadata, requests[i].timestamp, &results[i].headers));
+  }
+  return results;
+}
+
+std::shared_ptr<MonitorObject> DatabaseInterface::toMonitorObject(RetrievedObject&& retrieved)
+{
+  if (retrieved.object == nullptr) {
+    return nullptr;
+  }
+  std::shared_ptr<MonitorObject> mo;
+  if (auto* stored = dynamic_cast<MonitorObject*>(retrieved.object.get())) {
+    // objects stored by QC < 0.25 are full MonitorObjects
+    retrieved.object.release();
+    mo.reset(stored);
+  } else {
+    mo = std::make_shared<MonitorObject>(retrieved.object.release(), retrieved.headers["qc_task_name"], retrieved.headers["qc_detector_name"]);
+    mo->addMetadata(retrieved.headers);
+  }
+  mo->setIsOwner(true);
+  return mo;
+}
+
+std::shared_ptr<QualityObject> DatabaseInterface::toQualityObject(RetrievedObject&& retrieved)
+{
+  std::shared_ptr<QualityObject> qo;
+  if (auto* stored = dynamic_cast<QualityObject*>(retrieved.object.get())) {
+    retrieved.object.release();
+    qo.reset(stored);
+    qo->addMetadata(retrieved.headers);
+  }
+  return qo;
+}
+
+} // namespace o2::quality_control::repository
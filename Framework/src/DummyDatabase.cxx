@@ -74,6 +74,16 @@ std::vector<std::string> DummyDatabase::getPublishedObjectNames(std::string)
   return std::vector<std::string>();
 }
 
+std::vector<std::string> DummyDatabase::getListing(std::string)
+{
+  return std::vector<std::string>();
+}
+
+std::vector<uint64_t> DummyDatabase::getTimestampsForObject(std::string)
+{
+  return std::vector<uint64_t>();
+}
+
 void DummyDatabase::truncate(std::string, std::string)
 {
 }
@@ -24,6 +24,7 @@
 #include "QualityControl/PostProcessingDevice.h"
 #include "QualityControl/Version.h"
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/Calculators.h"
 
 #include <Configuration/ConfigurationFactory.h>
 #include <Framework/DataSpecUtils.h>
@@ -34,6 +35,8 @@
 #include <DataSampling/DataSampling.h>
 
 #include <algorithm>
+#include <cmath>
+#include <set>
 
 using namespace o2::framework;
 using namespace o2::configuration;
@@ -47,6 +50,89 @@ using SubSpec = o2::header::DataHeader::SubSpecificationType;
 namespace o2::quality_control::core
 {
 
+namespace
+{
+
+// The costs used to choose the cheapest topology of Mergers, the defaults of o2-qc-location-calculator.
+constexpr double costCPU = 118.0; // [currency/CPU]
+constexpr double costRAM = 0.005; // [currency/MB]
+
+/// Returns the number of Mergers in each layer for a local task, as configured with "mergersPerLayer" or "mergerLayers".
+std::vector<size_t> getMergersPerLayer(const std::string& taskName, const ptree& taskConfig, size_t numberOfLocalMachines, double cycleDurationSeconds)
+{
+  if (taskConfig.count("mergersPerLayer")) {
+    if (taskConfig.count("mergerLayers")) {
+      throw std::runtime_error("Configuration error: mergersPerLayer and mergerLayers cannot be both set for the task " + taskName);
+    }
+    std::vector<size_t> mergersPerLayer;
+    for (const auto& [key, value] : taskConfig.get_child("mergersPerLayer")) {
+      mergersPerLayer.push_back(value.get_value<size_t>());
+    }
+    if (mergersPerLayer.empty() || mergersPerLayer.back() != 1) {
+      throw std::runtime_error("Configuration error: the last layer of Mergers of the task " + taskName + " should have one Merger");
+    }
+    return mergersPerLayer;
+  }
+
+  // the reduction factor is the maximum number of inputs of one Merger
+  size_t R = numberOfLocalMachines;
+  auto mergerLayers = taskConfig.get<std::string>("mergerLayers", "1");
+  if (mergerLayers == "auto") {
+    auto mosSize = taskConfig.get<int>("monitorObjectsSizeMB", 100);
+    auto mergerPerformance = taskConfig.get<double>("mergerPerformance", 25.0);
+    auto [cheapestR, costOfCPU, costOfRAM] = calculators::cheapestMergers(
+      costCPU, costRAM, numberOfLocalMachines, mosSize, cycleDurationSeconds, [mergerPerformance](double) { return mergerPerformance; });
+    if (std::isfinite(costOfCPU + costOfRAM)) {
+      R = cheapestR;
+    } else if (numberOfLocalMachines > 1) {
+      ILOG(Warning, Support) << "Mergers of the task " << taskName << " would not keep up with their inputs with any topology, using one layer" << ENDM;
+    }
+  } else {
+    size_t numberOfLayers = std::stoul(mergerLayers);
+    if (numberOfLayers == 0) {
+      throw std::runtime_error("Configuration error: the task " + taskName + " needs at least one layer of Mergers");
+    }
+    // the smallest reduction factor which fits in the requested number of layers
+    R = 2;
+    while (R < numberOfLocalMachines && calculators::mergersPerLayer(numberOfLocalMachines, R).size() > numberOfLayers) {
+      R++;
+    }
+  }
+  return calculators::mergersPerLayer(numberOfLocalMachines, std::max<size_t>(R, 2));
+}
+
+/// Spreads the checks over the given number of shards, balancing their estimated cost.
+/// The cost of a check is the number of objects it looks at. A check of all the objects is assumed to look at all
+/// the objects named by the checks of the same inputs.
+std::vector<std::vector<Check>> shardChecks(const std::vector<Check>& checks, size_t numberOfShards)
+{
+  std::set<std::string> namedObjects;
+  for (const auto& check : checks) {
+    auto names = check.getObjectsNames();
+    namedObjects.insert(names.begin(), names.end());
+  }
+  std::vector<std::pair<size_t, const Check*>> costs;
+  for (const auto& check : checks) {
+    auto cost = check.getAllObjectsOption() ? namedObjects.size() : check.getObjectsNames().size();
+    costs.emplace_back(std::max<size_t>(cost, 1), &check);
+  }
+  // the most expensive checks first, each of them to the cheapest shard so far. The order is kept for equal costs,
+  // so that the checks of each shard, thus its name, do not depend on the sorting implementation.
+  std::stable_sort(costs.begin(), costs.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  numberOfShards = std::max<size_t>(1, std::min(numberOfShards, checks.size()));
+  std::vector<std::vector<Check>> shards(numberOfShards);
+  std::vector<size_t> shardCosts(numberOfShards, 0);
+  for (const auto& [cost, check] : costs) {
+    auto cheapest = std::distance(shardCosts.begin(), std::min_element(shardCosts.begin(), shardCosts.end()));
+    shards[cheapest].push_back(*check);
+    shardCosts[cheapest] += cost;
+  }
+  return shards;
+}
+
+} // namespace
+
 framework::WorkflowSpec InfrastructureGenerator::generateStandaloneInfrastructure(std::string configurationSource)
 {
   WorkflowSpec workflow;
@@ -168,7 +254,8 @@ o2::framework::WorkflowSpec InfrastructureGenerator::generateRemoteInfrastructur
 
           generateMergers(workflow, taskName, numberOfLocalMachines,
                           taskConfig.get<double>("cycleDurationSeconds"),
-                          taskConfig.get<std::string>("mergingMode", "delta"));
+                          taskConfig.get<std::string>("mergingMode", "delta"),
+                          getMergersPerLayer(taskName, taskConfig, numberOfLocalMachines, taskConfig.get<double>("cycleDurationSeconds")));
 
         } else if (taskConfig.get<std::string>("location") == "remote") {
 
@@ -227,6 +314,7 @@ void InfrastructureGenerator::customizeInfrastructure(std::vector<framework::Com
   MergerBuilder::customizeInfrastructure(policies);
   CheckRunnerFactory::customizeInfrastructure(policies);
   AggregatorRunnerFactory::customizeInfrastructure(policies);
+  PostProcessingDevice::customizeInfrastructure(policies);
 }
 
 void InfrastructureGenerator::printVersion()
@@ -311,7 +399,7 @@ void InfrastructureGenerator::generateLocalTaskRemoteProxy(framework::WorkflowSp
 
 void InfrastructureGenerator::generateMergers(framework::WorkflowSpec& workflow, std::string taskName,
                                               size_t numberOfLocalMachines, double cycleDurationSeconds,
-                                              std::string mergingMode)
+                                              std::string mergingMode, std::vector<size_t> mergersPerLayer)
 {
   Inputs mergerInputs;
   for (size_t id = 1; id <= numberOfLocalMachines; id++) {
@@ -332,10 +420,15 @@ void InfrastructureGenerator::generateMergers(framework::WorkflowSpec& workflow,
   mergerConfig.inputObjectTimespan = { (mergingMode.empty() || mergingMode == "delta") ? InputObjectsTimespan::LastDifference : InputObjectsTimespan::FullHistory };
   mergerConfig.publicationDecision = { PublicationDecision::EachNSeconds, cycleDurationSeconds };
   mergerConfig.mergedObjectTimespan = { MergedObjectTimespan::FullHistory, 0 };
-  // for now one merger should be enough, multiple layers to be supported later
-  mergerConfig.topologySize = { TopologySize::NumberOfLayers, 1 };
+  mergerConfig.topologySize = { TopologySize::MergersPerLayer, mergersPerLayer };
   mergersBuilder.setConfig(mergerConfig);
 
+  std::string mergersPerLayerList;
+  for (auto mergers : mergersPerLayer) {
+    mergersPerLayerList += " " + std::to_string(mergers);
+  }
+  ILOG(Info, Support) << "Mergers of the task " << taskName << " per layer:" << mergersPerLayerList << ENDM;
+
   mergersBuilder.generateInfrastructure(workflow);
 }
 
@@ -348,6 +441,7 @@ vector<OutputSpec> InfrastructureGenerator::generateCheckRunners(framework::Work
   std::map<std::string, o2::framework::InputSpec> tasksOutputMap; // all active tasks' output, as inputs, keyed by their label
   std::map<InputNames, Checks> checksMap;                         // all the Checks defined in the config mapped keyed by their sorted inputNames
   std::map<InputNames, InputNames> storeVectorMap;
+  std::map<std::string, size_t> shardsMap; // number of CheckRunners requested for the checks of a task, keyed by its output label
 
   auto config = ConfigurationFactory::getConfiguration(configurationSource);
 
@@ -356,6 +450,7 @@ vector<OutputSpec> InfrastructureGenerator::generateCheckRunners(framework::Work
       if (taskConfig.get<bool>("active", true)) {
         InputSpec taskOutput{ taskName, TaskRunner::createTaskDataOrigin(), TaskRunner::createTaskDataDescription(taskName) };
         tasksOutputMap.insert({ DataSpecUtils::label(taskOutput), taskOutput });
+        shardsMap[DataSpecUtils::label(taskOutput)] = taskConfig.get<size_t>("checkRunnerShards", 1);
       }
     }
   }
@@ -426,7 +521,7 @@ vector<OutputSpec> InfrastructureGenerator::generateCheckRunners(framework::Work
     }
   }
 
-  // Create CheckRunners: 1 per set of inputs
+  // Create CheckRunners: 1 per set of inputs, or more if their tasks request it
   CheckRunnerFactory checkRunnerFactory;
   vector<framework::OutputSpec> checkRunnerOutputs; // needed later for the aggregators
   for (auto& [inputNames, checks] : checksMap) {
@@ -443,9 +538,19 @@ vector<OutputSpec> InfrastructureGenerator::generateCheckRunners(framework::Work
     ILOG(Info, Devel) << ENDM;
 
     if (!checks.empty()) { // Create a CheckRunner for the grouped checks
-      DataProcessorSpec spec = checkRunnerFactory.create(checks, configurationSource, storeVectorMap[inputNames]);
-      workflow.emplace_back(spec);
-      checkRunnerOutputs.insert(checkRunnerOutputs.end(), spec.outputs.begin(), spec.outputs.end());
+      size_t numberOfShards = 1;
+      for (const auto& name : inputNames) {
+        if (auto shards = shardsMap.find(name); shards != shardsMap.end()) {
+          numberOfShards = std::max(numberOfShards, shards->second);
+        }
+      }
+      auto shards = shardChecks(checks, numberOfShards);
+      for (size_t shard = 0; shard < shards.size(); shard++) {
+        // the objects are stored only once, by the first shard
+        DataProcessorSpec spec = checkRunnerFactory.create(shards[shard], configurationSource, shard == 0 ? storeVectorMap[inputNames] : InputNames{});
+        workflow.emplace_back(spec);
+        checkRunnerOutputs.insert(checkRunnerOutputs.end(), spec.outputs.begin(), spec.outputs.end());
+      }
     } else { // If there are no checks, create a sink CheckRunner
       DataProcessorSpec spec = checkRunnerFactory.createSinkDevice(tasksOutputMap.find(inputNames[0])->second, configurationSource);
       workflow.emplace_back(spec);
@@ -0,0 +1,92 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyTracing.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/LatencyTracing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace o2::quality_control::core
+{
+
+namespace latency_tracing
+{
+
+namespace
+{
+
+std::optional<uint64_t> getTime(const std::map<std::string, std::string>& metadata, const char* key)
+{
+  auto it = metadata.find(key);
+  if (it == metadata.end()) {
+    return std::nullopt;
+  }
+  try {
+    return std::stoull(it->second);
+  } catch (...) {
+    return std::nullopt;
+  }
+}
+
+} // namespace
+
+uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::map<std::string, std::string> getTaskMetadata(const std::map<std::string, std::string>& metadata)
+{
+  std::map<std::string, std::string> result;
+  for (const char* key : { cycleKey, cycleEndKey, publicationKey }) {
+    if (auto it = metadata.find(key); it != metadata.end()) {
+      result.insert(*it);
+    }
+  }
+  return result;
+}
+
+bool isPublishedLater(const std::map<std::string, std::string>& first, const std::map<std::string, std::string>& second)
+{
+  auto firstTime = getTime(first, publicationKey);
+  auto secondTime = getTime(second, publicationKey);
+  return firstTime.has_value() && (!secondTime.has_value() || *firstTime > *secondTime);
+}
+
+std::optional<double> getSecondsSince(const std::map<std::string, std::string>& metadata, const char* key, uint64_t reference)
+{
+  auto time = getTime(metadata, key);
+  if (!time.has_value()) {
+    return std::nullopt;
+  }
+  return (static_cast<double>(reference) - static_cast<double>(*time)) / 1000.0;
+}
+
+} // namespace latency_tracing
+
+double LatencyStatistics::getQuantile(double q)
+{
+  if (mSamples.empty()) {
+    return 0;
+  }
+  // nearest-rank method
+  auto rank = static_cast<size_t>(std::ceil(std::clamp(q, 0.0, 1.0) * mSamples.size()));
+  auto nth = mSamples.begin() + (rank > 0 ? rank - 1 : 0);
+  std::nth_element(mSamples.begin(), nth, mSamples.end());
+  return *nth;
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,466 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalDatabase.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/LocalDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/Version.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "Common/Exceptions.h"
+// ROOT
+#include <TBufferJSON.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+// std
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <system_error>
+#include <tuple>
+#include <unistd.h>
+// misc
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+using namespace AliceO2::Common;
+using namespace o2::quality_control::core;
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace o2::quality_control::repository
+{
+
+namespace
+{
+const char* const objectKey = "ccdb_object";
+const char* const metadataKey = "ccdb_meta";
+const char* const versionExtension = ".root";
+
+using Metadata = std::map<std::string, std::string>;
+
+long currentTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Parses "<valid from>_<valid until>_<creation time>[_<sequence>]", returns false if the name does not follow this format.
+// The sequence is added to the versions created in the same millisecond as an existing one.
+bool parseVersionName(const std::string& name, long& validFrom, long& validUntil, long& created, int& sequence)
+{
+  int length = 0;
+  sequence = 0;
+  if (sscanf(name.c_str(), "%ld_%ld_%ld%n", &validFrom, &validUntil, &created, &length) == 3 && name[length] == '\0') {
+    return true;
+  }
+  return sscanf(name.c_str(), "%ld_%ld_%ld_%d%n", &validFrom, &validUntil, &created, &sequence, &length) == 4 &&
+         name[length] == '\0' && sequence > 0;
+}
+
+bool hasVersions(const fs::path& directory)
+{
+  for (const auto& entry : fs::directory_iterator(directory)) {
+    long validFrom, validUntil, created;
+    int sequence;
+    if (entry.is_regular_file() && entry.path().extension() == versionExtension &&
+        parseVersionName(entry.path().stem().string(), validFrom, validUntil, created, sequence)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+void LocalDatabase::connect(std::string host, std::string /*database*/, std::string /*username*/, std::string /*password*/)
+{
+  if (host.empty()) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("The directory of the local repository is not specified"));
+  }
+  mRoot = host;
+  fs::create_directories(mRoot);
+  ILOG(Info, Support) << "Local repository in " << mRoot.string() << ENDM;
+}
+
+void LocalDatabase::connect(const std::unordered_map<std::string, std::string>& config)
+{
+  auto path = config.find("path");
+  connect(path != config.end() ? path->second : "", "", "", "");
+}
+
+fs::path LocalDatabase::getDirectory(const std::string& path) const
+{
+  if (mRoot.empty()) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("The local repository is not connected"));
+  }
+  auto relative = fs::path(path).relative_path().lexically_normal();
+  if (!relative.empty() && *relative.begin() == "..") {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("The path " + path + " is outside of the repository"));
+  }
+  return mRoot / relative;
+}
+
+std::vector<LocalDatabase::ObjectVersion> LocalDatabase::getVersions(const std::string& path) const
+{
+  std::vector<ObjectVersion> versions;
+  auto directory = getDirectory(path);
+  std::error_code ec;
+  for (const auto& entry : fs::directory_iterator(directory, ec)) {
+    ObjectVersion version;
+    if (entry.is_regular_file() && entry.path().extension() == versionExtension &&
+        parseVersionName(entry.path().stem().string(), version.validFrom, version.validUntil, version.created, version.sequence)) {
+      version.file = entry.path();
+      versions.push_back(std::move(version));
+    }
+  }
+  std::sort(versions.begin(), versions.end(), [](const ObjectVersion& a, const ObjectVersion& b) {
+    return std::tie(a.validFrom, a.created, a.sequence) < std::tie(b.validFrom, b.created, b.sequence);
+  });
+  return versions;
+}
+
+std::optional<LocalDatabase::ObjectVersion> LocalDatabase::findVersion(const std::string& path, const Metadata& metadata, long timestamp,
+                                                                       const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  if (timestamp == -1) {
+    timestamp = currentTimestamp();
+  }
+  long notAfter = createdNotAfter.empty() ? std::numeric_limits<long>::max() : std::stol(createdNotAfter);
+  long notBefore = createdNotBefore.empty() ? std::numeric_limits<long>::min() : std::stol(createdNotBefore);
+
+  auto versions = getVersions(path);
+  for (auto version = versions.rbegin(); version != versions.rend(); ++version) {
+    if (version->validFrom > timestamp || version->validUntil <= timestamp ||
+        version->created > notAfter || version->created < notBefore) {
+      continue;
+    }
+    if (!metadata.empty()) {
+      auto versionMetadata = readMetadata(version->file);
+      if (!std::all_of(metadata.begin(), metadata.end(), [&](const auto& filter) {
+            auto value = versionMetadata.find(filter.first);
+            return value != versionMetadata.end() && value->second == filter.second;
+          })) {
+        continue;
+      }
+    }
+    return *version;
+  }
+  return std::nullopt;
+}
+
+void LocalDatabase::store(const void* obj, const TClass* cl, const std::string& path, Metadata metadata, long from, long to)
+{
+  if (obj == nullptr || cl == nullptr) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Cannot store a null pointer or an object without dictionary."));
+  }
+  if (path.empty() || path.find_first_of("\t\n ") != string::npos) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Object path '" + path + "' can't be empty nor contain white spaces. Do not store."));
+  }
+
+  long created = currentTimestamp();
+  if (from == -1) {
+    from = created;
+  }
+  if (to == -1) {
+    to = from + 1000l * 60 * 60 * 24 * 365 * 10; // ~10 years since the start of validity
+  }
+  metadata["qc_version"] = Version::GetQcVersion().getString();
+
+  auto directory = getDirectory(path);
+  fs::create_directories(directory);
+  auto versionName = std::to_string(from) + "_" + std::to_string(to) + "_" + std::to_string(created);
+  // the file gets its final name only once complete, so that readers never open it half-written.
+  // Several threads of a process can store the same object at the same time, each of them needs its own file.
+  static std::atomic<unsigned long> temporaryFileCounter{ 0 };
+  auto temporaryFile = directory / (versionName + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(temporaryFileCounter++));
+
+  ILOG(Debug, Support) << "Storing object " << path << " of type " << cl->GetName() << ENDM;
+  {
+    std::unique_ptr<TFile> tfile(TFile::Open(temporaryFile.c_str(), "RECREATE"));
+    if (tfile == nullptr || tfile->IsZombie()) {
+      BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not create the file " + temporaryFile.string()));
+    }
+    if (tfile->WriteObjectAny(obj, cl, objectKey) <= 0 ||
+        tfile->WriteObjectAny(&metadata, TClass::GetClass(typeid(Metadata)), metadataKey) <= 0) {
+      tfile->Close();
+      fs::remove(temporaryFile);
+      BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not write the object " + path));
+    }
+    tfile->Close();
+  }
+
+  // a version created in the same millisecond must not be replaced, the new one gets the next free sequence number.
+  // link() fails if the name is taken, unlike rename(), so that two concurrent stores cannot get the same one.
+  for (int sequence = 0;; sequence++) {
+    auto file = directory / (versionName + (sequence > 0 ? "_" + std::to_string(sequence) : "") + versionExtension);
+    if (link(temporaryFile.c_str(), file.c_str()) == 0) {
+      break;
+    }
+    if (errno != EEXIST) {
+      std::error_code ec(errno, std::generic_category());
+      fs::remove(temporaryFile);
+      BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not create the file " + file.string() + ": " + ec.message()));
+    }
+  }
+  fs::remove(temporaryFile);
+}
+
+void* LocalDatabase::read(const ObjectVersion& version, TClass* expected, Metadata* headers) const
+{
+  std::unique_ptr<TFile> tfile(TFile::Open(version.file.c_str(), "READ"));
+  if (tfile == nullptr || tfile->IsZombie()) {
+    ILOG(Error, Support) << "Could not open the file " << version.file.string() << ENDM;
+    return nullptr;
+  }
+  void* object = tfile->GetObjectChecked(objectKey, expected);
+  if (object == nullptr) {
+    ILOG(Error, Support) << "The object in " << version.file.string() << " is not a " << expected->GetName() << ENDM;
+    return nullptr;
+  }
+  // histograms are attached to the file they are read from, they would be deleted when it is closed
+  if (expected->InheritsFrom(TObject::Class())) {
+    auto* histogram = dynamic_cast<TH1*>(static_cast<TObject*>(expected->DynamicCast(TObject::Class(), object)));
+    if (histogram != nullptr) {
+      histogram->SetDirectory(nullptr);
+    }
+  }
+
+  if (headers != nullptr) {
+    auto* metadata = static_cast<Metadata*>(tfile->GetObjectChecked(metadataKey, TClass::GetClass(typeid(Metadata))));
+    if (metadata != nullptr) {
+      headers->insert(metadata->begin(), metadata->end());
+      delete metadata;
+    }
+    (*headers)["Valid-From"] = std::to_string(version.validFrom);
+    (*headers)["Valid-Until"] = std::to_string(version.validUntil);
+    (*headers)["Created"] = std::to_string(version.created);
+  }
+  return object;
+}
+
+Metadata LocalDatabase::readMetadata(const fs::path& file)
+{
+  Metadata result;
+  std::unique_ptr<TFile> tfile(TFile::Open(file.c_str(), "READ"));
+  if (tfile != nullptr && !tfile->IsZombie()) {
+    auto* metadata = static_cast<Metadata*>(tfile->GetObjectChecked(metadataKey, TClass::GetClass(typeid(Metadata))));
+    if (metadata != nullptr) {
+      result = *metadata;
+      delete metadata;
+    }
+  }
+  return result;
+}
+
+void LocalDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, Metadata const& metadata,
+                             std::string const& detectorName, std::string const& taskName, long from, long to)
+{
+  auto* cl = TClass::GetClass(typeInfo);
+  Metadata fullMetadata(metadata);
+  fullMetadata["qc_detector_name"] = detectorName;
+  fullMetadata["qc_task_name"] = taskName;
+  fullMetadata["ObjectType"] = cl != nullptr ? cl->GetName() : "";
+  store(obj, cl, path, std::move(fullMetadata), from, to);
+}
+
+void LocalDatabase::storeMO(std::shared_ptr<const MonitorObject> mo, long from, long to)
+{
+  if (mo->getName().empty() || mo->getTaskName().empty()) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Object and task names can't be empty. Do not store. "));
+  }
+
+  // the object is stored unencapsulated, as in the CCDB
+  Metadata metadata = mo->getMetadataMap();
+  metadata["qc_detector_name"] = mo->getDetectorName();
+  metadata["qc_task_name"] = mo->getTaskName();
+  metadata["ObjectType"] = mo->getObject()->IsA()->GetName();
+  store(mo->getObject(), mo->getObject()->IsA(), mo->getPath(), std::move(metadata), from, to);
+}
+
+void LocalDatabase::storeQO(std::shared_ptr<const QualityObject> qo, long from, long to)
+{
+  Metadata metadata = qo->getMetadataMap();
+  metadata["qc_quality"] = std::to_string(qo->getQuality().getLevel());
+  metadata["qc_detector_name"] = qo->getDetectorName();
+  metadata["qc_check_name"] = qo->getCheckName();
+  store(qo.get(), QualityObject::Class(), qo->getPath(), std::move(metadata), from, to);
+}
+
+void* LocalDatabase::retrieveAny(std::type_info const& tinfo, std::string const& path, Metadata const& metadata, long timestamp,
+                                 Metadata* headers, const std::string& createdNotAfter, const std::string& createdNotBefore)
+{
+  auto* cl = TClass::GetClass(tinfo);
+  if (cl == nullptr) {
+    ILOG(Error, Support) << "Could not retrieve the object " << path << ", its type has no dictionary" << ENDM;
+    return nullptr;
+  }
+  auto version = findVersion(path, metadata, timestamp, createdNotAfter, createdNotBefore);
+  if (!version.has_value()) {
+    ILOG(Error, Support) << "We could NOT retrieve the object " << path << "." << ENDM;
+    return nullptr;
+  }
+  return read(version.value(), cl, headers);
+}
+
+TObject* LocalDatabase::retrieveTObject(std::string path, Metadata const& metadata, long timestamp, Metadata* headers)
+{
+  return static_cast<TObject*>(retrieveAny(typeid(TObject), path, metadata, timestamp, headers));
+}
+
+std::shared_ptr<MonitorObject> LocalDatabase::retrieveMO(std::string taskName, std::string objectName, long timestamp)
+{
+  Metadata headers;
+  TObject* obj = retrieveTObject(taskName + "/" + objectName, {}, timestamp, &headers);
+  if (obj == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<MonitorObject> mo;
+  if (auto* storedMO = dynamic_cast<MonitorObject*>(obj)) {
+    mo.reset(storedMO);
+  } else {
+    mo = make_shared<MonitorObject>(obj, headers["qc_task_name"], headers["qc_detector_name"]);
+    mo->addMetadata(headers);
+  }
+  mo->setIsOwner(true);
+  return mo;
+}
+
+std::shared_ptr<QualityObject> LocalDatabase::retrieveQO(std::string qoPath, long timestamp)
+{
+  Metadata headers;
+  TObject* obj = retrieveTObject(qoPath, {}, timestamp, &headers);
+  std::shared_ptr<QualityObject> qo(dynamic_cast<QualityObject*>(obj));
+  if (qo == nullptr) {
+    delete obj;
+    ILOG(Error, Devel) << "Could not cast the object " << qoPath << " to QualityObject" << ENDM;
+  } else {
+    qo->addMetadata(headers);
+  }
+  return qo;
+}
+
+std::string LocalDatabase::retrieveMOJson(std::string taskName, std::string objectName, long timestamp)
+{
+  return retrieveJson(taskName + "/" + objectName, timestamp, {});
+}
+
+std::string LocalDatabase::retrieveQOJson(std::string qoPath, long timestamp)
+{
+  return retrieveJson(qoPath, timestamp, {});
+}
+
+std::string LocalDatabase::retrieveJson(std::string path, long timestamp, const Metadata& metadata)
+{
+  Metadata headers;
+  std::unique_ptr<TObject> tobj(retrieveTObject(path, metadata, timestamp, &headers));
+  if (tobj == nullptr) {
+    return std::string();
+  }
+  TObject* toConvert = tobj.get();
+  if (auto* mo = dynamic_cast<MonitorObject*>(tobj.get())) {
+    toConvert = mo->getObject();
+  }
+  TString json = TBufferJSON::ConvertToJSON(toConvert);
+
+  rapidjson::Document jsonDocument;
+  if (jsonDocument.Parse(json.Data()).HasParseError()) {
+    ILOG(Error, Support) << "Unable to parse the JSON returned by TBufferJSON for object " << path << ENDM;
+    return std::string();
+  }
+  rapidjson::Document::AllocatorType& allocator = jsonDocument.GetAllocator();
+  rapidjson::Value object(rapidjson::Type::kObjectType);
+  for (auto const& [key, value] : headers) {
+    rapidjson::Value k(key.c_str(), allocator);
+    rapidjson::Value v(value.c_str(), allocator);
+    object.AddMember(k, v, allocator);
+  }
+  jsonDocument.AddMember("metadata", object, allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  jsonDocument.Accept(writer);
+  return buffer.GetString();
+}
+
+void LocalDatabase::disconnect()
+{
+  // NOOP for the local repository
+}
+
+void LocalDatabase::prepareTaskDataContainer(std::string taskName)
+{
+  fs::create_directories(getDirectory(taskName));
+}
+
+std::vector<std::string> LocalDatabase::getListing(std::string subpath)
+{
+  std::vector<std::string> result;
+  auto directory = getDirectory(subpath);
+  if (!fs::is_directory(directory)) {
+    return result;
+  }
+  if (hasVersions(directory)) {
+    result.push_back(directory.lexically_relative(mRoot).generic_string());
+  }
+  for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+    if (entry.is_directory() && hasVersions(entry.path())) {
+      result.push_back(entry.path().lexically_relative(mRoot).generic_string());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<uint64_t> LocalDatabase::getTimestampsForObject(std::string path)
+{
+  std::vector<uint64_t> timestamps;
+  for (const auto& version : getVersions(path)) {
+    timestamps.push_back(version.validFrom);
+  }
+  return timestamps;
+}
+
+std::vector<std::string> LocalDatabase::getPublishedObjectNames(std::string taskName)
+{
+  std::vector<std::string> result;
+  auto taskDirectory = getDirectory(taskName);
+  for (const auto& objectPath : getListing(taskName)) {
+    // same format as CcdbDatabase: the path relative to the task, starting with a slash
+    auto relative = (mRoot / objectPath).lexically_relative(taskDirectory).generic_string();
+    if (relative != ".") {
+      result.push_back("/" + relative);
+    }
+  }
+  return result;
+}
+
+void LocalDatabase::truncate(std::string taskName, std::string objectName)
+{
+  ILOG(Info, Support) << "Truncating data for " << taskName << "/" << objectName << ENDM;
+  if (objectName == "*") {
+    fs::remove_all(getDirectory(taskName));
+    return;
+  }
+  // the subdirectories are other objects, we keep them
+  for (const auto& version : getVersions(taskName + "/" + objectName)) {
+    fs::remove(version.file);
+  }
+}
+
+} // namespace o2::quality_control::repository
@@ -16,6 +16,7 @@
 #include "QualityControl/MonitorObjectCollection.h"
 
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/LatencyTracing.h"
 
 #include <Mergers/MergerAlgorithm.h>
 
@@ -39,6 +40,12 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
       if (otherMO && targetMO) {
         // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
         algorithm::merge(targetMO->getObject(), otherMO->getObject());
+        // the merged object is as recent as its latest contribution
+        if (latency_tracing::isPublishedLater(otherMO->getMetadataMap(), targetMO->getMetadataMap())) {
+          for (const auto& [key, value] : latency_tracing::getTaskMetadata(otherMO->getMetadataMap())) {
+            targetMO->addOrUpdateMetadata(key, value);
+          }
+        }
       } else {
         throw std::runtime_error("The target object or the other object could not be casted to MonitorObject.");
       }
@@ -20,6 +20,8 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include <Common/Exceptions.h>
 #include <TObjArray.h>
+#include <TH1.h>
+#include <THnBase.h>
 
 using namespace o2::quality_control::core;
 using namespace AliceO2::Common;
@@ -51,13 +53,14 @@ ObjectsManager::~ObjectsManager() = default;
 
 void ObjectsManager::startPublishing(TObject* object)
 {
-  if (mMonitorObjects->FindObject(object->GetName()) != 0) {
+  if (isBeingPublished(object->GetName())) {
     ILOG(Warning, Support) << "Object is already being published (" << object->GetName() << ")" << ENDM;
     BOOST_THROW_EXCEPTION(DuplicateObjectError() << errinfo_object_name(object->GetName()));
   }
   auto* newObject = new MonitorObject(object, mTaskName, mDetectorName);
   newObject->setIsOwner(false);
   mMonitorObjects->Add(newObject);
+  mMonitorObjectsByName.emplace(object->GetName(), newObject);
   mUpdateServiceDiscovery = true;
 }
 
@@ -97,23 +100,25 @@ void ObjectsManager::stopPublishing(TObject* object)
 
 void ObjectsManager::stopPublishing(const string& objectName)
 {
-  auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
+  auto* mo = getMonitorObject(objectName);
+  mLastPublishedContent.erase(mo);
+  mMonitorObjectsByName.erase(objectName);
   mMonitorObjects->Remove(mo);
 }
 
 bool ObjectsManager::isBeingPublished(const string& name)
 {
-  return (mMonitorObjects->FindObject(name.c_str()) != nullptr);
+  return mMonitorObjectsByName.count(name) > 0;
 }
 
-MonitorObject* ObjectsManager::getMonitorObject(std::string objectName)
+MonitorObject* ObjectsManager::getMonitorObject(const std::string& objectName)
 {
-  TObject* object = mMonitorObjects->FindObject(objectName.c_str());
-  if (object == nullptr) {
+  auto mo = mMonitorObjectsByName.find(objectName);
+  if (mo == mMonitorObjectsByName.end()) {
     ILOG(Error, Ops) << "ObjectsManager: Unable to find object \"" << objectName << "\"" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(objectName));
   }
-  return dynamic_cast<MonitorObject*>(object);
+  return mo->second;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(size_t index)
@@ -132,10 +137,67 @@ MonitorObjectCollection* ObjectsManager::getNonOwningArray() const
   return new MonitorObjectCollection(*mMonitorObjects);
 }
 
+MonitorObjectCollection* ObjectsManager::getNonOwningArrayOfModified(size_t keepAliveCalls)
+{
+  auto* array = new MonitorObjectCollection();
+  array->SetOwner(false);
+  for (auto tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    ContentSummary summary;
+    if (mo == nullptr || !summarizeContent(mo->getObject(), summary)) {
+      array->Add(tobj);
+      continue;
+    }
+    auto lastPublished = mLastPublishedContent.find(mo);
+    if (lastPublished == mLastPublishedContent.end() || lastPublished->second.content != summary) {
+      array->Add(mo);
+      mLastPublishedContent[mo] = { summary, 0 };
+    } else if (keepAliveCalls > 0 && ++lastPublished->second.skippedCalls >= keepAliveCalls) {
+      array->Add(mo);
+      lastPublished->second.skippedCalls = 0;
+    }
+  }
+  return array;
+}
+
+void ObjectsManager::markAllAsUnmodified()
+{
+  for (auto tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    ContentSummary summary;
+    if (mo != nullptr && summarizeContent(mo->getObject(), summary)) {
+      mLastPublishedContent[mo].content = summary;
+    }
+  }
+}
+
+void ObjectsManager::markAsModified(const MonitorObject* mo)
+{
+  mLastPublishedContent.erase(mo);
+}
+
+bool ObjectsManager::summarizeContent(const TObject* object, ContentSummary& summary)
+{
+  // TH1::GetStats() is O(1) when the statistics were accumulated by Fill(). It loops over the bins when they were not
+  // (fTsumw == 0, e.g. after SetBinContent()) or when an axis range is set, which is still cheaper than serializing.
+  if (auto* histogram = dynamic_cast<const TH1*>(object)) {
+    double stats[TH1::kNstat] = { 0 };
+    histogram->GetStats(stats);
+    summary = { histogram->GetEntries(), stats[0], stats[1] };
+    return true;
+  }
+  if (auto* histogram = dynamic_cast<const THnBase*>(object)) {
+    summary = { histogram->GetEntries(), histogram->GetSumw(), histogram->GetSumw2() };
+    return true;
+  }
+  return false;
+}
+
 void ObjectsManager::addMetadata(const std::string& objectName, const std::string& key, const std::string& value)
 {
   MonitorObject* mo = getMonitorObject(objectName);
   mo->addMetadata(key, value);
+  markAsModified(mo);
   ILOG(Debug, Devel) << "Added metadata on " << objectName << " : " << key << " -> " << value << ENDM;
 }
 
@@ -148,24 +210,28 @@ void ObjectsManager::setDefaultDrawOptions(const std::string& objectName, const
 {
   MonitorObject* mo = getMonitorObject(objectName);
   mo->addOrUpdateMetadata(gDrawOptionsKey, options);
+  markAsModified(mo);
 }
 
 void ObjectsManager::setDefaultDrawOptions(TObject* obj, const std::string& options)
 {
   MonitorObject* mo = getMonitorObject(obj->GetName());
   mo->addOrUpdateMetadata(gDrawOptionsKey, options);
+  markAsModified(mo);
 }
 
 void ObjectsManager::setDisplayHint(const std::string& objectName, const std::string& hints)
 {
   MonitorObject* mo = getMonitorObject(objectName);
   mo->addOrUpdateMetadata(gDisplayHintsKey, hints);
+  markAsModified(mo);
 }
 
 void ObjectsManager::setDisplayHint(TObject* obj, const std::string& hints)
 {
   MonitorObject* mo = getMonitorObject(obj->GetName());
   mo->addOrUpdateMetadata(gDisplayHintsKey, hints);
+  markAsModified(mo);
 }
 
 } // namespace o2::quality_control::core
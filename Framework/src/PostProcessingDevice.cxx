@@ -16,18 +16,27 @@
 #include "QualityControl/PostProcessingDevice.h"
 
 #include "QualityControl/PostProcessingRunner.h"
+#include "QualityControl/PostProcessingConfig.h"
+#include "QualityControl/TriggerHelpers.h"
+#include "QualityControl/Check.h"
 #include "QualityControl/QcInfoLogger.h"
 
 #include <Common/Exceptions.h>
 #include <Configuration/ConfigurationFactory.h>
 #include <Framework/CallbackService.h>
+#include <Framework/CompletionPolicyHelpers.h>
 #include <Framework/ControlService.h>
+#include <Framework/DeviceSpec.h>
+#include <Framework/InputRecordWalker.h>
+
+#include <string_view>
 
 using namespace AliceO2::Common;
 using namespace o2::configuration;
 using namespace o2::framework;
 
 constexpr auto outputBinding = "mo";
+constexpr std::string_view checkInputPrefix = "check-";
 
 namespace o2::quality_control::postprocessing
 {
@@ -43,6 +52,8 @@ void PostProcessingDevice::init(framework::InitContext& ctx)
   // todo: eventually we should retrieve the configuration from context
   auto config = ConfigurationFactory::getConfiguration(mConfigSource);
   mRunner->init(config->getRecursive());
+  // the results of the Checks in the workflow are received by this device, see run()
+  mRunner->setObjectNotifications(std::make_shared<ObjectNotifications>());
 
   // registering state machine callbacks
   ctx.services().get<CallbackService>().set(CallbackService::Id::Start, [this]() { start(); });
@@ -56,6 +67,13 @@ void PostProcessingDevice::run(framework::ProcessingContext& ctx)
   // the reference to DataAllocator does not change
   mRunner->setPublicationCallback(publishToDPL(ctx.outputs(), outputBinding));
 
+  // The results of the Checks are not read, their arrival is enough for the triggers
+  for (const auto& ref : InputRecordWalker(ctx.inputs())) {
+    if (std::string_view binding = ref.spec->binding; binding.substr(0, checkInputPrefix.size()) == checkInputPrefix) {
+      mRunner->notifyNewCheckResult(std::string(binding.substr(checkInputPrefix.size())));
+    }
+  }
+
   // When run returns false, it has done its processing.
   if (!mRunner->run()) {
     ctx.services().get<ControlService>().endOfStream();
@@ -81,6 +99,16 @@ header::DataDescription PostProcessingDevice::createPostProcessingDataDescriptio
   return description;
 }
 
+void PostProcessingDevice::customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies)
+{
+  auto matcher = [](framework::DeviceSpec const& device) {
+    return device.name.find(PostProcessingDevice::createPostProcessingIdString()) != std::string::npos;
+  };
+  auto callback = CompletionPolicyHelpers::consumeWhenAny().callback;
+
+  policies.emplace_back("postProcessingCompletionPolicy", matcher, callback);
+}
+
 void PostProcessingDevice::start()
 {
   mRunner->start();
@@ -106,11 +134,23 @@ framework::Inputs PostProcessingDevice::getInputsSpecs()
   o2::header::DataDescription timerDescription;
   timerDescription.runtimeInit(std::string("T-" + mRunner->getName()).substr(0, o2::header::DataDescription::size).c_str());
 
-  return { { "timer-pp-" + mRunner->getName(),
-             createPostProcessingDataOrigin(),
-             timerDescription,
-             0,
-             Lifetime::Timer } };
+  framework::Inputs inputs{ { "timer-pp-" + mRunner->getName(),
+                              createPostProcessingDataOrigin(),
+                              timerDescription,
+                              0,
+                              Lifetime::Timer } };
+
+  // The triggers are known only from the configuration, which PostProcessingRunner reads during the initialisation
+  auto config = ConfigurationFactory::getConfiguration(mConfigSource);
+  PostProcessingConfig ppConfig(mRunner->getName(), config->getRecursive());
+  std::vector<std::string> triggers;
+  triggers.insert(triggers.end(), ppConfig.initTriggers.begin(), ppConfig.initTriggers.end());
+  triggers.insert(triggers.end(), ppConfig.updateTriggers.begin(), ppConfig.updateTriggers.end());
+  triggers.insert(triggers.end(), ppConfig.stopTriggers.begin(), ppConfig.stopTriggers.end());
+  for (const auto& checkName : trigger_helpers::getCheckNamesInTriggers(triggers)) {
+    inputs.push_back({ std::string(checkInputPrefix) + checkName, "QC", checker::Check::createCheckerDataDescription(checkName), 0, Lifetime::Timeframe });
+  }
+  return inputs;
 }
 
 framework::Outputs PostProcessingDevice::getOutputSpecs()
@@ -13,13 +13,17 @@
 #include "QualityControl/PostProcessingFactory.h"
 #include "QualityControl/TriggerHelpers.h"
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/QcInfoLogger.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <Framework/DataAllocator.h>
+#include <Monitoring/MonitoringFactory.h>
+#include <Monitoring/Monitoring.h>
 
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::repository;
+using namespace o2::monitoring;
 
 namespace o2::quality_control::postprocessing
 {
@@ -36,6 +40,18 @@ void PostProcessingRunner::setPublicationCallback(MOCPublicationCallback callbac
   mPublicationCallback = callback;
 }
 
+void PostProcessingRunner::setObjectNotifications(std::shared_ptr<ObjectNotifications> notifications)
+{
+  mObjectNotifications = std::move(notifications);
+}
+
+void PostProcessingRunner::notifyNewCheckResult(const std::string& checkName, uint64_t timestamp)
+{
+  if (mObjectNotifications) {
+    mObjectNotifications->notify(checkName, timestamp);
+  }
+}
+
 void PostProcessingRunner::init(const boost::property_tree::ptree& config)
 {
   ILOG_INST.init("post/" + mName, config);
@@ -52,7 +68,8 @@ void PostProcessingRunner::init(const boost::property_tree::ptree& config)
   mDatabase->connect(dbConfig);
   ILOG(Info, Support) << "Database that is going to be used : " << ENDM;
   ILOG(Info, Support) << ">> Implementation : " << config.get<std::string>("qc.config.database.implementation") << ENDM;
-  ILOG(Info, Support) << ">> Host : " << config.get<std::string>("qc.config.database.host") << ENDM;
+  ILOG(Info, Support) << ">> Host : " << config.get<std::string>("qc.config.database.host", "") << ENDM;
+  initMonitoring(config);
 
   mObjectManager = std::make_shared<ObjectsManager>(mConfig.taskName, mConfig.detectorName, mConfig.consulUrl);
   mServices.registerService<DatabaseInterface>(mDatabase.get());
@@ -125,7 +142,7 @@ void PostProcessingRunner::runOverTimestamps(const std::vector<uint64_t>& timest
 void PostProcessingRunner::start()
 {
   if (mTaskState == TaskState::Created || mTaskState == TaskState::Finished) {
-    mInitTriggers = trigger_helpers::createTriggers(mConfig.initTriggers, mConfig);
+    mInitTriggers = trigger_helpers::createTriggers(mConfig.initTriggers, mConfig, mObjectNotifications);
     if (trigger_helpers::hasUserOrControlTrigger(mConfig.initTriggers)) {
       doInitialize({ TriggerType::UserOrControl });
     }
@@ -158,6 +175,8 @@ void PostProcessingRunner::reset()
   mTaskState = TaskState::INVALID;
 
   mTask.reset();
+  mRetrievalCache = nullptr;
+  mCollector.reset();
   mDatabase.reset();
   mServices = framework::ServiceRegistry();
   mObjectManager.reset();
@@ -175,8 +194,8 @@ void PostProcessingRunner::doInitialize(Trigger trigger)
   mTaskState = TaskState::Running;
 
   // We create the triggers just after task init (and not any sooner), so the timer triggers work as expected.
-  mUpdateTriggers = trigger_helpers::createTriggers(mConfig.updateTriggers, mConfig);
-  mStopTriggers = trigger_helpers::createTriggers(mConfig.stopTriggers, mConfig);
+  mUpdateTriggers = trigger_helpers::createTriggers(mConfig.updateTriggers, mConfig, mObjectNotifications);
+  mStopTriggers = trigger_helpers::createTriggers(mConfig.stopTriggers, mConfig, mObjectNotifications);
 }
 
 void PostProcessingRunner::doUpdate(Trigger trigger)
@@ -184,6 +203,7 @@ void PostProcessingRunner::doUpdate(Trigger trigger)
   ILOG(Info, Support) << "Updating the user task due to trigger '" << trigger << "'" << ENDM;
   mTask->update(trigger, mServices);
   mPublicationCallback(mObjectManager->getNonOwningArray(), trigger.timestamp, trigger.timestamp + objectValidity);
+  sendMetrics();
 }
 
 void PostProcessingRunner::doFinalize(Trigger trigger)
@@ -193,6 +213,34 @@ void PostProcessingRunner::doFinalize(Trigger trigger)
   mPublicationCallback(mObjectManager->getNonOwningArray(), trigger.timestamp, trigger.timestamp + objectValidity);
   mTaskState = TaskState::Finished;
 }
+void PostProcessingRunner::initMonitoring(const boost::property_tree::ptree& config)
+{
+  // for the time being, only the retrieval cache is monitored
+  auto* ccdb = dynamic_cast<CcdbDatabase*>(mDatabase.get());
+  mRetrievalCache = ccdb ? ccdb->getRetrievalCache() : nullptr;
+  if (mRetrievalCache == nullptr) {
+    return;
+  }
+  mCollector = MonitoringFactory::Get(config.get<std::string>("qc.config.monitoring.url", "infologger:///debug?qc"));
+  mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
+  mCollector->addGlobalTag("PostProcessingName", mName);
+  mTimer.reset(10000000); // 10 s.
+}
+
+void PostProcessingRunner::sendMetrics()
+{
+  if (mCollector == nullptr || !mTimer.isTimeout()) {
+    return;
+  }
+  mTimer.reset(10000000); // 10 s.
+  const auto& statistics = mRetrievalCache->getStatistics();
+  mCollector->send({ static_cast<int>(statistics.hits), "qc_repository_cache_hits" }, DerivedMetricMode::RATE);
+  mCollector->send({ static_cast<int>(statistics.misses), "qc_repository_cache_misses" }, DerivedMetricMode::RATE);
+  mCollector->send({ static_cast<int>(statistics.evictions), "qc_repository_cache_evictions" }, DerivedMetricMode::RATE);
+  mCollector->send({ static_cast<double>(statistics.bytes), "qc_repository_cache_bytes" });
+  mCollector->send({ static_cast<int>(statistics.entries), "qc_repository_cache_entries" });
+}
+
 const std::string& PostProcessingRunner::getName()
 {
   return mName;
@@ -0,0 +1,88 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RetrievalCache.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/RetrievalCache.h"
+
+namespace o2::quality_control::repository
+{
+
+RetrievalCache::RetrievalCache(size_t budget) : mBudget(budget)
+{
+}
+
+std::string RetrievalCache::makeKey(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  std::string key = path;
+  for (const auto& [name, value] : metadata) {
+    key += '\n' + name + '=' + value;
+  }
+  return key;
+}
+
+const RetrievalCache::Entry* RetrievalCache::find(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  auto versions = mVersions.find(makeKey(path, metadata));
+  if (versions == mVersions.end()) {
+    return nullptr;
+  }
+  // the version with the latest start of validity before the timestamp
+  auto version = versions->second.upper_bound(timestamp);
+  if (version == versions->second.begin()) {
+    return nullptr;
+  }
+  --version;
+  auto node = version->second;
+  if (node->entry->validUntil <= timestamp) {
+    return nullptr;
+  }
+  mNodes.splice(mNodes.begin(), mNodes, node);
+  return node->entry.get();
+}
+
+void RetrievalCache::insert(const std::string& path, const std::map<std::string, std::string>& metadata, std::unique_ptr<Entry> entry)
+{
+  if (entry == nullptr || entry->bytes > mBudget) {
+    return;
+  }
+  auto key = makeKey(path, metadata);
+  auto& versions = mVersions[key];
+  if (auto existing = versions.find(entry->validFrom); existing != versions.end()) {
+    erase(existing->second);
+  }
+  while (!mNodes.empty() && mStatistics.bytes + entry->bytes > mBudget) {
+    erase(std::prev(mNodes.end()));
+    mStatistics.evictions++;
+  }
+
+  mStatistics.bytes += entry->bytes;
+  mStatistics.entries++;
+  long validFrom = entry->validFrom;
+  mNodes.push_front({ key, std::move(entry) });
+  mVersions[key][validFrom] = mNodes.begin();
+}
+
+void RetrievalCache::erase(Nodes::iterator node)
+{
+  auto versions = mVersions.find(node->key);
+  versions->second.erase(node->entry->validFrom);
+  if (versions->second.empty()) {
+    mVersions.erase(versions);
+  }
+  mStatistics.bytes -= node->entry->bytes;
+  mStatistics.entries--;
+  mNodes.erase(node);
+}
+
+} // namespace o2::quality_control::repository
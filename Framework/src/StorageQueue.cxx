@@ -0,0 +1,203 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   StorageQueue.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/StorageQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+namespace
+{
+long currentTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+StorageQueue::StorageQueue(DatabaseCreator databaseCreator, Config config)
+  : mConfig(config)
+{
+  // the databases are created and connected first, in the caller's thread, so that a failure does not leave
+  // any worker running
+  std::vector<std::unique_ptr<DatabaseInterface>> databases;
+  for (size_t i = 0; i < std::max<size_t>(mConfig.threads, 1); i++) {
+    databases.emplace_back(databaseCreator());
+  }
+  for (auto& database : databases) {
+    mWorkers.emplace_back(&StorageQueue::runWorker, this, std::move(database));
+  }
+}
+
+StorageQueue::~StorageQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mWorkAvailable.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+bool StorageQueue::push(std::shared_ptr<const MonitorObject> mo)
+{
+  Entry entry;
+  entry.mo = mo;
+  return enqueue(mo->getPath(), std::move(entry));
+}
+
+bool StorageQueue::push(std::shared_ptr<const QualityObject> qo)
+{
+  Entry entry;
+  entry.qo = qo;
+  return enqueue(qo->getPath(), std::move(entry));
+}
+
+bool StorageQueue::enqueue(const std::string& path, Entry&& entry)
+{
+  entry.validFrom = currentTimestamp();
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto pending = mPending.find(path);
+    if (pending != mPending.end()) {
+      // an older version is still waiting, we keep only the newest one and its position in the queue
+      pending->second = std::move(entry);
+      mStatistics.pushed++;
+      mStatistics.coalesced++;
+      return true;
+    }
+    if (mPending.size() >= mConfig.capacity) {
+      mStatistics.dropped++;
+      return false;
+    }
+    mPending.emplace(path, std::move(entry));
+    mOrder.push_back(path);
+    mStatistics.pushed++;
+  }
+  mWorkAvailable.notify_one();
+  return true;
+}
+
+void StorageQueue::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mWorkDone.wait(lock, [this] { return mPending.empty() && mInFlight == 0; });
+}
+
+StorageQueue::Statistics StorageQueue::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Statistics statistics = mStatistics;
+  statistics.pending = mPending.size() + mInFlight;
+  return statistics;
+}
+
+std::string StorageQueue::popLastError()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::string error;
+  std::swap(error, mLastError);
+  return error;
+}
+
+core::LatencyStatistics StorageQueue::popStorageLatency()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  core::LatencyStatistics latency;
+  std::swap(latency, mStorageLatency);
+  return latency;
+}
+
+void StorageQueue::runWorker(std::unique_ptr<DatabaseInterface> database)
+{
+  const size_t batchSize = std::max<size_t>(mConfig.batchSize, 1);
+  std::vector<Entry> batch;
+  batch.reserve(batchSize);
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mInFlight -= batch.size();
+      batch.clear();
+      if (mPending.empty() && mInFlight == 0) {
+        mWorkDone.notify_all();
+      }
+
+      mWorkAvailable.wait(lock, [this] { return mStopping || !mPending.empty(); });
+      if (mPending.empty()) {
+        // we are stopping and there is nothing left to store
+        return;
+      }
+
+      while (!mOrder.empty() && batch.size() < batchSize) {
+        auto pending = mPending.find(mOrder.front());
+        batch.emplace_back(std::move(pending->second));
+        mPending.erase(pending);
+        mOrder.pop_front();
+      }
+      mInFlight += batch.size();
+    }
+
+    for (const auto& entry : batch) {
+      store(*database, entry);
+    }
+  }
+}
+
+void StorageQueue::store(DatabaseInterface& database, const Entry& entry)
+{
+  std::string error;
+  try {
+    if (entry.mo) {
+      database.storeMO(entry.mo, entry.validFrom);
+    } else {
+      database.storeQO(entry.qo, entry.validFrom);
+    }
+  } catch (boost::exception& e) {
+    error = boost::diagnostic_information(e);
+  } catch (std::exception& e) {
+    error = e.what();
+  } catch (...) {
+    error = "unknown exception while storing an object";
+  }
+
+  std::optional<double> latency;
+  if (error.empty() && entry.qo) {
+    latency = latency_tracing::getSecondsSince(entry.qo->getMetadataMap(), latency_tracing::cycleEndKey);
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (error.empty()) {
+    (entry.mo ? mStatistics.storedMOs : mStatistics.storedQOs)++;
+    if (latency) {
+      mStorageLatency.add(*latency);
+    }
+  } else {
+    mStatistics.failed++;
+    mLastError = error;
+  }
+}
+
+} // namespace o2::quality_control::repository
@@ -38,6 +38,7 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/TaskFactory.h"
+#include "QualityControl/LatencyTracing.h"
 
 #include <string>
 #include <TFile.h>
@@ -108,8 +109,8 @@ void TaskRunner::init(InitContext& iCtx)
   mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
   mCollector->addGlobalTag("TaskName", mTaskConfig.taskName);
 
-  // setup publisher
-  mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID);
+  // setup publisher, an empty consul url disables the service discovery
+  mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID, mTaskConfig.consulUrl.empty());
 
   // setup user's task
   TaskFactory f;
@@ -147,6 +148,10 @@ void TaskRunner::run(ProcessingContext& pCtx)
     finishCycle(pCtx.outputs());
     if (mResetAfterPublish) {
       mTask->reset();
+      if (mTaskConfig.publishOnlyModified) {
+        // the deltas start from scratch, empty objects do not have to be sent
+        mObjectsManager->markAllAsUnmodified();
+      }
     }
     if (mTaskConfig.maxNumberCycles < 0 || mCycleNumber < mTaskConfig.maxNumberCycles) {
       startCycle();
@@ -367,6 +372,21 @@ void TaskRunner::loadTaskConfig()
   mTaskConfig.consulUrl = mConfigFile->get<std::string>("qc.config.consul.url", "http://consul-test.cern.ch:8500");
   mTaskConfig.conditionUrl = mConfigFile->get<std::string>("qc.config.conditionDB.url", "http://ccdb-test.cern.ch:8080");
   mTaskConfig.saveToFile = taskConfigTree.get<std::string>("saveObjectsToFile", "");
+  mTaskConfig.publishOnlyModified = taskConfigTree.get<bool>("publishOnlyModified", false);
+  if (mTaskConfig.publishOnlyModified && taskConfigTree.get<std::string>("location", "remote") == "local" &&
+      taskConfigTree.get<std::string>("mergingMode", "delta") == "entire") {
+    // Mergers replace the whole collection of a producer in this mode, objects which are not sent would be lost.
+    ILOG(Warning, Support) << "publishOnlyModified cannot be used with the mergingMode 'entire', it is disabled" << ENDM;
+    mTaskConfig.publishOnlyModified = false;
+  }
+  if (mTaskConfig.publishOnlyModified) {
+    mTaskConfig.publishOnlyModifiedKeepAlive = taskConfigTree.get<size_t>("publishOnlyModifiedKeepAlive", mTaskConfig.publishOnlyModifiedKeepAlive);
+    if (mTaskConfig.publishOnlyModifiedKeepAlive == 0 && hasOnAllChecks()) {
+      // an OnAll Check is ready only when all its objects were updated, which might never happen again
+      ILOG(Warning, Support) << "publishOnlyModified without keep-alive is used with Checks with the policy 'OnAll', "
+                             << "they will not run anymore once one of their objects stops changing" << ENDM;
+    }
+  }
   try {
     mTaskConfig.customParameters = mConfigFile->getRecursiveMap("qc.tasks." + mTaskConfig.taskName + ".taskParameters");
   } catch (...) {
@@ -380,6 +400,30 @@ void TaskRunner::loadTaskConfig()
   ILOG(Info, Support) << ">> Cycle duration seconds : " << mTaskConfig.cycleDurationSeconds << ENDM;
   ILOG(Info, Support) << ">> Max number cycles : " << mTaskConfig.maxNumberCycles << ENDM;
   ILOG(Info, Support) << ">> Save to file : " << mTaskConfig.saveToFile << ENDM;
+  ILOG(Info, Support) << ">> Publish only modified objects : " << mTaskConfig.publishOnlyModified << ENDM;
+  if (mTaskConfig.publishOnlyModified) {
+    ILOG(Info, Support) << ">> Unmodified objects are sent every " << mTaskConfig.publishOnlyModifiedKeepAlive << " cycles" << ENDM;
+  }
+}
+
+bool TaskRunner::hasOnAllChecks() const
+{
+  if (mConfigFile->getRecursive("qc").count("checks") == 0) {
+    return false;
+  }
+  for (const auto& [checkName, checkConfig] : mConfigFile->getRecursive("qc.checks")) {
+    (void)checkName;
+    if (!checkConfig.get<bool>("active", true) || checkConfig.get<std::string>("policy", "OnAny") != "OnAll") {
+      continue;
+    }
+    for (const auto& [key, dataSource] : checkConfig.get_child("dataSource")) {
+      (void)key;
+      if (dataSource.get<std::string>("type", "") == "Task" && dataSource.get<std::string>("name", "") == mTaskConfig.taskName) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 std::string TaskRunner::validateDetectorName(std::string name) const
@@ -447,9 +491,10 @@ void TaskRunner::startCycle()
 
 void TaskRunner::finishCycle(DataAllocator& outputs)
 {
+  auto cycleEndTime = latency_tracing::now();
   mTask->endOfCycle();
 
-  mNumberObjectsPublishedInCycle += publish(outputs);
+  mNumberObjectsPublishedInCycle += publish(outputs, cycleEndTime);
   mTotalNumberObjectsPublished += mNumberObjectsPublishedInCycle;
   saveToFile();
 
@@ -505,7 +550,7 @@ void TaskRunner::publishCycleStats()
                      .addValue(wholeRunRate, "per_second_whole_run"));
 }
 
-int TaskRunner::publish(DataAllocator& outputs)
+int TaskRunner::publish(DataAllocator& outputs, uint64_t cycleEndTime)
 {
   ILOG(Debug, Support) << "Send data from " << mTaskConfig.taskName << " len: " << mObjectsManager->getNumberPublishedObjects() << ENDM;
   AliceO2::Common::Timer publicationDurationTimer;
@@ -513,8 +558,23 @@ int TaskRunner::publish(DataAllocator& outputs)
   auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mMonitorObjectsSpec);
   // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
   // owning them. The array is created by new and must be cleaned up by the caller
-  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  std::unique_ptr<MonitorObjectCollection> array(mTaskConfig.publishOnlyModified ? mObjectsManager->getNonOwningArrayOfModified(mTaskConfig.publishOnlyModifiedKeepAlive)
+                                                                                  : mObjectsManager->getNonOwningArray());
   int objectsPublished = array->GetEntries();
+  if (mTaskConfig.publishOnlyModified) {
+    ILOG(Debug, Support) << (mObjectsManager->getNumberPublishedObjects() - objectsPublished) << " objects were not modified and are not sent" << ENDM;
+  }
+
+  auto cycle = std::to_string(mCycleNumber);
+  auto cycleEnd = std::to_string(cycleEndTime);
+  auto publication = std::to_string(latency_tracing::now());
+  for (auto* object : *array) {
+    if (auto* mo = dynamic_cast<MonitorObject*>(object)) {
+      mo->addOrUpdateMetadata(latency_tracing::cycleKey, cycle);
+      mo->addOrUpdateMetadata(latency_tracing::cycleEndKey, cycleEnd);
+      mo->addOrUpdateMetadata(latency_tracing::publicationKey, publication);
+    }
+  }
 
   outputs.snapshot(
     Output{ concreteOutput.origin,
@@ -0,0 +1,74 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/ThreadPool.h"
+
+#include <algorithm>
+
+namespace o2::quality_control::core
+{
+
+ThreadPool::ThreadPool(size_t threads)
+{
+  for (size_t i = 0; i < std::max<size_t>(threads, 1); i++) {
+    mThreads.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& thread : mThreads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> job)
+{
+  std::packaged_task<void()> task(std::move(job));
+  auto future = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mJobs.emplace_back(std::move(task));
+  }
+  mJobAvailable.notify_one();
+  return future;
+}
+
+void ThreadPool::run()
+{
+  while (true) {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobAvailable.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+      if (mJobs.empty()) {
+        return;
+      }
+      task = std::move(mJobs.front());
+      mJobs.pop_front();
+    }
+    // exceptions are caught by the packaged_task and passed to the future
+    task();
+  }
+}
+
+} // namespace o2::quality_control::core
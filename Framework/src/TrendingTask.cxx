@@ -73,17 +73,28 @@ void TrendingTask::trendValues(uint64_t timestamp, repository::DatabaseInterface
   //  enough if we trend across runs).
   mMetaData.runNumber = -1;
 
+  // all the objects are retrieved at once, so that the repository can fetch them concurrently
+  std::vector<repository::DatabaseInterface::RetrievalRequest> requests;
+  requests.reserve(mConfig.dataSources.size());
+  for (auto& dataSource : mConfig.dataSources) {
+    if (dataSource.type == "repository" || dataSource.type == "repository-quality") {
+      requests.push_back({ dataSource.path + "/" + dataSource.name, static_cast<long>(timestamp) });
+    }
+  }
+  auto retrieved = qcdb.retrieveMany(requests);
+
+  size_t index = 0;
   for (auto& dataSource : mConfig.dataSources) {
 
     // todo: make it agnostic to MOs, QOs or other objects. Let the reductor cast to whatever it needs.
     if (dataSource.type == "repository") {
-      auto mo = qcdb.retrieveMO(dataSource.path, dataSource.name, timestamp);
+      auto mo = repository::DatabaseInterface::toMonitorObject(std::move(retrieved[index++]));
       TObject* obj = mo ? mo->getObject() : nullptr;
       if (obj) {
         mReductors[dataSource.name]->update(obj);
       }
     } else if (dataSource.type == "repository-quality") {
-      auto qo = qcdb.retrieveQO(dataSource.path + "/" + dataSource.name, timestamp);
+      auto qo = repository::DatabaseInterface::toQualityObject(std::move(retrieved[index++]));
       if (qo) {
         mReductors[dataSource.name]->update(qo.get());
       }
@@ -48,7 +48,7 @@ std::optional<double> string2Seconds(std::string str)
   }
 }
 
-TriggerFcn triggerFactory(std::string trigger, const PostProcessingConfig& config)
+TriggerFcn triggerFactory(std::string trigger, const PostProcessingConfig& config, std::shared_ptr<const ObjectNotifications> notifications)
 {
   // todo: should we accept many versions of trigger names?
   std::string triggerLowerCase = trigger;
@@ -69,28 +69,35 @@ TriggerFcn triggerFactory(std::string trigger, const PostProcessingConfig& confi
   } else if (triggerLowerCase.find("newobject") != std::string::npos) {
     // we expect the config string to be:
     // newobject:[qcdb/ccdb]:qc/path/to/object
+    // or
+    // newobject:check:CheckName
     std::vector<std::string> tokens;
     boost::split(tokens, trigger, boost::is_any_of(":"));
 
     if (tokens.size() != 3) {
       throw std::invalid_argument(
         "The new object trigger is configured incorrectly. The expected format is "
-        "'newobject:[qcdb/ccdb]:qc/path/to/object', received `" +
+        "'newobject:[qcdb/ccdb]:qc/path/to/object' or 'newobject:check:CheckName', received `" +
         trigger + "'");
     }
 
+    if (tokens[2].empty()) {
+      throw std::invalid_argument("The third token in '" + trigger + "' is empty, but it should contain the object path or the check name");
+    }
+
     std::string dbUrl;
     boost::algorithm::to_lower(tokens[1]);
     if (tokens[1] == "qcdb") {
       dbUrl = config.qcdbUrl;
     } else if (tokens[1] == "ccdb") {
       dbUrl = config.ccdbUrl;
+    } else if (tokens[1] == "check") {
+      if (notifications == nullptr) {
+        throw std::invalid_argument("The trigger '" + trigger + "' can be used only when the task runs in a QC workflow (o2-qc)");
+      }
+      return triggers::NewObjectInWorkflow(notifications, tokens[2]);
     } else {
-      throw std::invalid_argument("The second token in '" + trigger + "' should be either qcdb or ccdb");
-    }
-
-    if (tokens[2].empty()) {
-      throw std::invalid_argument("The third token in '" + trigger + "' is empty, but it should contain the object path");
+      throw std::invalid_argument("The second token in '" + trigger + "' should be either qcdb, ccdb or check");
     }
 
     return triggers::NewObject(dbUrl, tokens[2]);
@@ -116,12 +123,12 @@ Trigger tryTrigger(std::vector<TriggerFcn>& triggerFcns)
   return { TriggerType::No };
 }
 
-std::vector<TriggerFcn> createTriggers(const std::vector<std::string>& triggerNames, const PostProcessingConfig& config)
+std::vector<TriggerFcn> createTriggers(const std::vector<std::string>& triggerNames, const PostProcessingConfig& config, std::shared_ptr<const ObjectNotifications> notifications)
 {
   std::vector<TriggerFcn> triggerFcns;
   triggerFcns.reserve(triggerNames.size());
   for (const auto& triggerName : triggerNames) {
-    triggerFcns.push_back(triggerFactory(triggerName, config));
+    triggerFcns.push_back(triggerFactory(triggerName, config, notifications));
   }
   return triggerFcns;
 }
@@ -134,4 +141,18 @@ bool hasUserOrControlTrigger(const std::vector<std::string>& triggerNames)
          }) != triggerNames.end();
 }
 
+std::vector<std::string> getCheckNamesInTriggers(const std::vector<std::string>& triggerNames)
+{
+  std::vector<std::string> checkNames;
+  for (const auto& triggerName : triggerNames) {
+    std::vector<std::string> tokens;
+    boost::split(tokens, triggerName, boost::is_any_of(":"));
+    if (tokens.size() == 3 && boost::iequals(tokens[0], "newobject") && boost::iequals(tokens[1], "check") && !tokens[2].empty() &&
+        std::find(checkNames.begin(), checkNames.end(), tokens[2]) == checkNames.end()) {
+      checkNames.push_back(tokens[2]);
+    }
+  }
+  return checkNames;
+}
+
 } // namespace o2::quality_control::postprocessing::trigger_helpers
@@ -37,6 +37,25 @@ uint64_t Trigger::msSinceEpoch()
   return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
 }
 
+void ObjectNotifications::notify(const std::string& source, uint64_t timestamp)
+{
+  auto& notification = mNotifications[source];
+  notification.count++;
+  notification.timestamp = timestamp;
+}
+
+size_t ObjectNotifications::getCount(const std::string& source) const
+{
+  auto it = mNotifications.find(source);
+  return it != mNotifications.end() ? it->second.count : 0;
+}
+
+uint64_t ObjectNotifications::getLastTimestamp(const std::string& source) const
+{
+  auto it = mNotifications.find(source);
+  return it != mNotifications.end() ? it->second.timestamp : 0;
+}
+
 namespace triggers
 {
 
@@ -175,6 +194,19 @@ TriggerFcn NewObject(std::string databaseUrl, std::string objectPath)
   };
 }
 
+TriggerFcn NewObjectInWorkflow(std::shared_ptr<const ObjectNotifications> notifications, std::string source)
+{
+  // several notifications between two checks of the trigger result in one trigger with the latest timestamp
+  auto seenCount = notifications->getCount(source);
+  return [notifications, source = std::move(source), seenCount]() mutable -> Trigger {
+    if (auto count = notifications->getCount(source); count != seenCount) {
+      seenCount = count;
+      return { TriggerType::NewObject, notifications->getLastTimestamp(source) };
+    }
+    return { TriggerType::No };
+  };
+}
+
 } // namespace triggers
 
 } // namespace o2::quality_control::postprocessing
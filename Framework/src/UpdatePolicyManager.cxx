@@ -18,6 +18,8 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "Common/Exceptions.h"
 
+#include <algorithm>
+
 using namespace AliceO2::Common;
 
 namespace o2::quality_control::checker
@@ -30,19 +32,17 @@ void UpdatePolicyManager::updateGlobalRevision()
     // mGlobalRevision cannot be 0
     // 0 means overflow, increment and update all check revisions to 0
     ++mGlobalRevision;
-    for (auto& actor : mPoliciesByActor) {
-      updateActorRevision(actor.second.actorName, 0);
+    for (auto& policy : mPolicies) {
+      updateActorRevision(policy.actorName, 0);
     }
   }
 }
 
 void UpdatePolicyManager::updateActorRevision(const std::string& actorName, RevisionType revision)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
-    ILOG(Error, Support) << "Cannot update revision for " << actorName << " : object not found" << ENDM;
-    BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
-  }
-  mPoliciesByActor.at(actorName).revision = revision;
+  auto& policy = getPolicy(actorName);
+  policy.revision = revision;
+  markUpdatedInputs(policy, mObjectsRevision);
 }
 
 void UpdatePolicyManager::updateActorRevision(std::string actorName)
@@ -52,7 +52,23 @@ void UpdatePolicyManager::updateActorRevision(std::string actorName)
 
 void UpdatePolicyManager::updateObjectRevision(std::string objectName, RevisionType revision)
 {
-  mObjectsRevision[objectName] = revision;
+  size_t objectId = getObjectId(objectName);
+  bool firstTime = !mObjectsReceived[objectId];
+  mObjectsRevision[objectId] = revision;
+  mObjectsReceived[objectId] = true;
+
+  // only the policies which use this object are affected
+  for (const auto& [policyIndex, inputIndex] : mObjectsSubscribers[objectId]) {
+    auto& policy = mPolicies[policyIndex];
+    bool updated = revision > policy.revision;
+    if (policy.updatedInputs[inputIndex] != updated) {
+      policy.updatedInputs[inputIndex] = updated;
+      updated ? policy.updatedInputsCount++ : policy.updatedInputsCount--;
+    }
+    if (firstTime) {
+      policy.receivedInputsCount++;
+    }
+  }
 }
 
 void UpdatePolicyManager::updateObjectRevision(std::string objectName)
@@ -62,106 +78,123 @@ void UpdatePolicyManager::updateObjectRevision(std::string objectName)
 
 void UpdatePolicyManager::addPolicy(std::string actorName, std::string policyType, std::vector<std::string> objectNames, bool allObjects, bool policyHelper)
 {
-  UpdatePolicyFunctionType policy;
+  UpdatePolicyType type;
   if (policyType == "OnAll") {
-    /** 
-     * Run check if all MOs are updated 
-     */
-    policy = [&, actorName]() {
-      for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-        if (mObjectsRevision.count(objectName) == 0 || mObjectsRevision.at(objectName) <= mPoliciesByActor.at(actorName).revision) {
-          return false;
-        }
-      }
-      return true;
-    };
+    type = UpdatePolicyType::OnAll;
   } else if (policyType == "OnAnyNonZero") {
-    /**
-     * Return true if any declared MOs were updated
-     * Guarantee that all declared MOs are available
-     */
-    policy = [&, actorName]() {
-      if (!mPoliciesByActor.at(actorName).policyHelperFlag) {
-        // Check if all monitor objects are available
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          if (!mObjectsRevision.count(objectName)) {
-            return false;
-          }
-        }
-        // From now on all MOs are available
-        mPoliciesByActor.at(actorName).policyHelperFlag = true;
-      }
-
-      for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-        if (mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-          return true;
-        }
-      }
-      return false;
-    };
-
+    type = UpdatePolicyType::OnAnyNonZero;
   } else if (policyType == "OnEachSeparately") {
-    /**
-     * Return true if any declared object were updated.
-     * This is the same behaviour as OnAny.
-     */
-    policy = [&, actorName]() {
-      if (mPoliciesByActor.at(actorName).allInputObjects) {
-        return true;
-      }
-
-      for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-        if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-          return true;
-        }
-      }
-      return false;
-    };
-
+    type = UpdatePolicyType::OnEachSeparately;
   } else if (policyType == "_OnGlobalAny") {
-    /**
-     * Return true if any MOs were updated.
-     * Inner policy - used for `"MOs": "all"`
-     * Might return true even if MO is not used in Check
-     */
-
-    policy = []() {
-      // Expecting check of this policy only if any change
-      return true;
-    };
-
+    type = UpdatePolicyType::OnGlobalAny;
   } else if (policyType == "OnAny") {
-    /**
-     * Default behaviour
-     *
-     * Run check if any declared MOs are updated
-     * Does not guarantee to contain all declared MOs 
-     */
-    policy = [&, actorName]() {
-      for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-        if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-          return true;
-        }
-      }
-      return false;
-    };
+    type = UpdatePolicyType::OnAny;
   } else {
     ILOG(Fatal, Ops) << "No policy named '" << policyType << "'" << ENDM;
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("No policy named '" + policyType + "'"));
   }
 
-  mPoliciesByActor[actorName] = { actorName, policy, objectNames, allObjects, policyHelper };
+  size_t policyIndex;
+  if (auto existing = mPoliciesIndex.find(actorName); existing != mPoliciesIndex.end()) {
+    // the actor is redefined, we forget about its previous inputs
+    policyIndex = existing->second;
+    for (auto& subscribers : mObjectsSubscribers) {
+      subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [policyIndex](const auto& subscriber) { return subscriber.first == policyIndex; }),
+                        subscribers.end());
+    }
+  } else {
+    policyIndex = mPolicies.size();
+    mPolicies.emplace_back();
+    mPoliciesIndex[actorName] = policyIndex;
+  }
 
-  ILOG(Info, Devel) << "Added a policy : " << mPoliciesByActor[actorName] << ENDM;
+  UpdatePolicy policy{ actorName, type, objectNames, allObjects, policyHelper };
+  for (size_t inputIndex = 0; inputIndex < objectNames.size(); inputIndex++) {
+    size_t objectId = getObjectId(objectNames[inputIndex]);
+    policy.inputObjectsIds.push_back(objectId);
+    mObjectsSubscribers[objectId].emplace_back(policyIndex, inputIndex);
+  }
+  markUpdatedInputs(policy, mObjectsRevision);
+  for (auto objectId : policy.inputObjectsIds) {
+    policy.receivedInputsCount += mObjectsReceived[objectId];
+  }
+  mPolicies[policyIndex] = std::move(policy);
+
+  ILOG(Info, Devel) << "Added a policy : " << mPolicies[policyIndex] << ENDM;
 }
 
 bool UpdatePolicyManager::isReady(const std::string& actorName)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
-    ILOG(Error, Support) << "Cannot check if " << actorName << " is ready : object not found" << ENDM;
+  return getPolicy(actorName).isReady();
+}
+
+size_t UpdatePolicyManager::getObjectId(const std::string& objectName)
+{
+  auto [it, inserted] = mObjectsIds.emplace(objectName, mObjectsRevision.size());
+  if (inserted) {
+    mObjectsRevision.push_back(0);
+    mObjectsReceived.push_back(false);
+    mObjectsSubscribers.emplace_back();
+  }
+  return it->second;
+}
+
+UpdatePolicy& UpdatePolicyManager::getPolicy(const std::string& actorName)
+{
+  auto policyIndex = mPoliciesIndex.find(actorName);
+  if (policyIndex == mPoliciesIndex.end()) {
+    ILOG(Error, Support) << "Cannot find the policy of " << actorName << " : object not found" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
   }
-  return mPoliciesByActor.at(actorName).isReady();
+  return mPolicies[policyIndex->second];
+}
+
+void UpdatePolicyManager::markUpdatedInputs(UpdatePolicy& policy, const std::vector<RevisionType>& objectsRevision)
+{
+  policy.updatedInputs.assign(policy.inputObjectsIds.size(), false);
+  policy.updatedInputsCount = 0;
+  for (size_t inputIndex = 0; inputIndex < policy.inputObjectsIds.size(); inputIndex++) {
+    if (objectsRevision[policy.inputObjectsIds[inputIndex]] > policy.revision) {
+      policy.updatedInputs[inputIndex] = true;
+      policy.updatedInputsCount++;
+    }
+  }
+}
+
+bool UpdatePolicy::isReady()
+{
+  switch (type) {
+    case UpdatePolicyType::OnAll:
+      // Run check if all MOs are updated
+      return updatedInputsCount == inputObjectsIds.size();
+    case UpdatePolicyType::OnAnyNonZero:
+      // Return true if any declared MOs were updated
+      // Guarantee that all declared MOs are available
+      if (!policyHelperFlag) {
+        if (receivedInputsCount < inputObjectsIds.size()) {
+          return false;
+        }
+        // From now on all MOs are available
+        policyHelperFlag = true;
+      }
+      return updatedInputsCount > 0;
+    case UpdatePolicyType::OnEachSeparately:
+      // Return true if any declared object were updated.
+      // This is the same behaviour as OnAny.
+      return allInputObjects || updatedInputsCount > 0;
+    case UpdatePolicyType::OnGlobalAny:
+      // Return true if any MOs were updated.
+      // Inner policy - used for `"MOs": "all"`
+      // Might return true even if MO is not used in Check
+      // Expecting check of this policy only if any change
+      return true;
+    case UpdatePolicyType::OnAny:
+      // Default behaviour
+      // Run check if any declared MOs are updated
+      // Does not guarantee to contain all declared MOs
+      return updatedInputsCount > 0;
+  }
+  return false;
 }
 
 std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) // output
@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkObjectsManager.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/ObjectsManager.h"
+
+#include <TH1F.h>
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace o2::quality_control::core;
+
+// Measures the look-up of published objects by name with the number of objects published by large detector tasks.
+// BM_FindObject reproduces the former behaviour (TObjArray::FindObject, linear scan) as a reference.
+
+namespace
+{
+
+struct Fixture {
+  explicit Fixture(size_t numberOfObjects) : manager("test", "TST", "", 0, true)
+  {
+    for (size_t i = 0; i < numberOfObjects; i++) {
+      auto name = "histogram_" + std::to_string(i);
+      histograms.emplace_back(std::make_unique<TH1F>(name.c_str(), name.c_str(), 10, 0, 10));
+      names.emplace_back(name);
+      manager.startPublishing(histograms.back().get());
+    }
+  }
+
+  ObjectsManager manager;
+  std::vector<std::unique_ptr<TH1F>> histograms;
+  std::vector<std::string> names;
+};
+
+} // namespace
+
+static void BM_GetMonitorObject(benchmark::State& state)
+{
+  Fixture fixture(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.manager.getMonitorObject(fixture.names[i]));
+    i = (i + 1) % fixture.names.size();
+  }
+}
+
+static void BM_FindObject(benchmark::State& state)
+{
+  Fixture fixture(state.range(0));
+  std::unique_ptr<MonitorObjectCollection> array(fixture.manager.getNonOwningArray());
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(array->FindObject(fixture.names[i].c_str()));
+    i = (i + 1) % fixture.names.size();
+  }
+}
+
+static void BM_IsBeingPublished(benchmark::State& state)
+{
+  Fixture fixture(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.manager.isBeingPublished(fixture.names[i]));
+    i = (i + 1) % fixture.names.size();
+  }
+}
+
+BENCHMARK(BM_GetMonitorObject)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_FindObject)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_IsBeingPublished)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -15,6 +15,7 @@
 
 #include "QualityControl/CheckRunnerFactory.h"
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/LatencyTracing.h"
 #include "getTestDataDirectory.h"
 #include <DataSampling/DataSampling.h>
 #include <Common/Exceptions.h>
@@ -135,3 +136,27 @@ BOOST_AUTO_TEST_CASE(test_check_postprocessing)
   // Beautify should run - single MO declared
   BOOST_CHECK(testCheck.mBeautify);
 }
+
+BOOST_AUTO_TEST_CASE(test_check_latency_tracing)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+
+  Check check("singleCheck", configFilePath);
+  check.init();
+
+  TestCheck testCheck;
+  check.setCheckInterface(dynamic_cast<CheckInterface*>(&testCheck));
+
+  auto mo = std::make_shared<MonitorObject>();
+  mo->addMetadata({ { latency_tracing::cycleKey, "7" }, { latency_tracing::cycleEndKey, "1000" }, { latency_tracing::publicationKey, "1200" } });
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap = { { "skeletonTask/example", mo } };
+
+  auto qos = check.check(moMap);
+  BOOST_REQUIRE_EQUAL(qos.size(), 1);
+  const auto& metadata = qos[0]->getMetadataMap();
+  // the QO carries the tracing metadata of the MO it was produced from
+  BOOST_CHECK_EQUAL(metadata.at(latency_tracing::cycleKey), "7");
+  BOOST_CHECK_EQUAL(metadata.at(latency_tracing::cycleEndKey), "1000");
+  BOOST_CHECK_EQUAL(metadata.at(latency_tracing::publicationKey), "1200");
+  BOOST_CHECK_EQUAL(metadata.count(latency_tracing::checkKey), 1);
+}
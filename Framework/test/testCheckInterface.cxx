@@ -73,6 +73,25 @@ class TestCheck : public checker::CheckInterface
   string mValidString;
 };
 
+// Relies only on the view-based check, it should not need a copy of the objects in a map
+class TestViewCheck : public checker::CheckInterface
+{
+ public:
+  void configure(std::string) override {}
+
+  Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) override
+  {
+    return checkMapThroughView(moMap);
+  }
+
+  Quality checkView(const checker::MonitorObjectsView& moView) override
+  {
+    return moView.size() == 2 && moView.find("second") != nullptr && moView.find("third") == nullptr ? Quality::Good : Quality::Bad;
+  }
+
+  void beautify(std::shared_ptr<MonitorObject>, Quality = Quality::Null) override {}
+};
+
 } /* namespace test */
 } /* namespace o2::quality_control */
 
@@ -96,3 +115,31 @@ BOOST_AUTO_TEST_CASE(test_invoke_all_methods)
 
   BOOST_CHECK_EQUAL(testCheck.getAcceptedType(), "TObjString");
 }
+
+BOOST_AUTO_TEST_CASE(test_monitor_objects_view)
+{
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap = {
+    { "first", std::make_shared<MonitorObject>(new TObjString("A string"), "first") },
+    { "second", std::make_shared<MonitorObject>(new TObjString("A different string"), "second") },
+    { "third", std::make_shared<MonitorObject>(new TObjString("A string"), "third") }
+  };
+  std::vector<const checker::MonitorObjectsView::value_type*> entries{ &*moMap.find("first"), &*moMap.find("second") };
+  checker::MonitorObjectsView view(entries.data(), entries.size());
+
+  // the legacy checks see a map with the viewed objects only
+  test::TestCheck testCheck;
+  testCheck.configure("A string");
+  checker::CheckInterface& legacyCheck = testCheck;
+  BOOST_CHECK_EQUAL(legacyCheck.checkView(view), Quality::Good);
+  BOOST_CHECK_EQUAL(legacyCheck.checkView(checker::MonitorObjectsView(entries.data() + 1, 1)), Quality::Bad);
+
+  test::TestViewCheck viewCheck;
+  BOOST_CHECK_EQUAL(viewCheck.checkView(view), Quality::Good);
+  BOOST_CHECK_EQUAL(viewCheck.checkView(checker::MonitorObjectsView()), Quality::Bad);
+  // the map is passed through the view
+  std::map<std::string, std::shared_ptr<MonitorObject>> twoObjects = { { "first", moMap["first"] }, { "second", moMap["second"] } };
+  BOOST_CHECK_EQUAL(viewCheck.check(&twoObjects), Quality::Good);
+  BOOST_CHECK_EQUAL(viewCheck.check(&moMap), Quality::Bad);
+  BOOST_CHECK(view.find("first") == moMap["first"]);
+  BOOST_CHECK_EQUAL(view.toMap().size(), 2);
+}
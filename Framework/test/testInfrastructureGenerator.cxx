@@ -155,6 +155,74 @@ BOOST_AUTO_TEST_CASE(qc_factory_remote_test)
   BOOST_CHECK(postprocessingTask != workflow.end());
 }
 
+BOOST_AUTO_TEST_CASE(qc_factory_merger_topology_test)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testMergerTopology.json";
+  auto workflow = InfrastructureGenerator::generateRemoteInfrastructure(configFilePath);
+
+  auto countMergers = [&workflow](const std::string& taskName) {
+    return std::count_if(
+      workflow.begin(), workflow.end(),
+      [&taskName](const DataProcessorSpec& d) {
+        return d.name.find("MERGER") != std::string::npos && d.name.find(taskName) != std::string::npos;
+      });
+  };
+  auto finalMerger = [&workflow](const std::string& taskName) {
+    return std::find_if(
+      workflow.begin(), workflow.end(),
+      [&taskName](const DataProcessorSpec& d) {
+        return d.name.find("MERGER") != std::string::npos && d.name.find(taskName) != std::string::npos &&
+               d.outputs.size() == 1 && DataSpecUtils::getOptionalSubSpec(d.outputs[0]).value_or(-1) == 0;
+      });
+  };
+
+  // one Merger by default
+  BOOST_CHECK_EQUAL(countMergers("defaultTask"), 1);
+  // 5 inputs -> 2 Mergers -> 1 Merger
+  BOOST_CHECK_EQUAL(countMergers("fixedTask"), 3);
+  // 9 inputs in 2 layers -> 3 Mergers -> 1 Merger
+  BOOST_CHECK_EQUAL(countMergers("layersTask"), 4);
+  // a Merger can handle only 10 inputs per cycle -> 2 Mergers -> 1 Merger
+  BOOST_CHECK_EQUAL(countMergers("autoTask"), 3);
+
+  // the last layer publishes the merged objects
+  for (const auto& taskName : { "defaultTask", "fixedTask", "layersTask", "autoTask" }) {
+    BOOST_CHECK(finalMerger(taskName) != workflow.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(qc_factory_check_runner_shards_test)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testCheckRunnerShards.json";
+  auto workflow = InfrastructureGenerator::generateRemoteInfrastructure(configFilePath);
+
+  auto checkRunnerCount = std::count_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("QC-CHECK-RUNNER") != std::string::npos;
+    });
+  BOOST_REQUIRE_EQUAL(checkRunnerCount, 2);
+
+  // checkA looks at 3 objects, checkC at 2 and checkB at 1, so checkA is alone in its shard
+  auto shardA = std::find_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name == "QC-CHECK-RUNNER-checkA" &&
+             d.inputs.size() == 1 &&
+             d.outputs.size() == 1;
+    });
+  BOOST_CHECK(shardA != workflow.end());
+
+  auto shardBC = std::find_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("QC-CHECK-RUNNER") != std::string::npos &&
+             d.inputs.size() == 1 &&
+             d.outputs.size() == 2;
+    });
+  BOOST_CHECK(shardBC != workflow.end());
+}
+
 BOOST_AUTO_TEST_CASE(qc_factory_standalone_test)
 {
   std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
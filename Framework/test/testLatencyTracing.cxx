@@ -0,0 +1,96 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLatencyTracing.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/LatencyTracing.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+#include <TH1F.h>
+
+#define BOOST_TEST_MODULE LatencyTracing test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+
+BOOST_AUTO_TEST_CASE(test_latency_statistics_quantiles)
+{
+  LatencyStatistics statistics;
+  BOOST_CHECK(statistics.empty());
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0.5), 0);
+
+  for (int i = 100; i > 0; i--) {
+    statistics.add(i);
+  }
+  BOOST_CHECK_EQUAL(statistics.size(), 100);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0.5), 50);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0.99), 99);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(1), 100);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0), 1);
+
+  statistics.reset();
+  statistics.add(3);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0.5), 3);
+  BOOST_CHECK_EQUAL(statistics.getQuantile(0.99), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_latency_tracing_metadata)
+{
+  using namespace latency_tracing;
+  std::map<std::string, std::string> older{ { cycleKey, "3" }, { cycleEndKey, "1000" }, { publicationKey, "1500" }, { "other", "x" } };
+  std::map<std::string, std::string> newer{ { cycleKey, "4" }, { cycleEndKey, "2000" }, { publicationKey, "2500" } };
+  std::map<std::string, std::string> none{ { publicationKey, "invalid" } };
+
+  auto taskMetadata = getTaskMetadata(older);
+  BOOST_CHECK_EQUAL(taskMetadata.size(), 3);
+  BOOST_CHECK_EQUAL(taskMetadata.count("other"), 0);
+
+  BOOST_CHECK(isPublishedLater(newer, older));
+  BOOST_CHECK(!isPublishedLater(older, newer));
+  BOOST_CHECK(isPublishedLater(older, none));
+  BOOST_CHECK(!isPublishedLater(none, older));
+
+  BOOST_CHECK_CLOSE(*getSecondsSince(older, cycleEndKey, 3500), 2.5, 0.001);
+  BOOST_CHECK(!getSecondsSince(none, publicationKey, 3500).has_value());
+  BOOST_CHECK(!getSecondsSince(none, cycleEndKey, 3500).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(test_latency_tracing_merging)
+{
+  using namespace latency_tracing;
+  auto makeCollection = [](const std::string& published) {
+    auto* mo = new MonitorObject(new TH1F("histo", "histo", 10, 0, 10), "task", "TST");
+    mo->setIsOwner(true);
+    mo->addMetadata({ { cycleKey, published }, { cycleEndKey, published }, { publicationKey, published } });
+    auto* collection = new MonitorObjectCollection();
+    collection->SetOwner(true);
+    collection->Add(mo);
+    return collection;
+  };
+
+  // the merged object takes the metadata of its latest contribution
+  std::unique_ptr<MonitorObjectCollection> target(makeCollection("1000"));
+  std::unique_ptr<MonitorObjectCollection> newer(makeCollection("2000"));
+  std::unique_ptr<MonitorObjectCollection> older(makeCollection("500"));
+  target->merge(newer.get());
+  target->merge(older.get());
+
+  auto* mo = dynamic_cast<MonitorObject*>(target->FindObject("histo"));
+  BOOST_REQUIRE(mo);
+  BOOST_CHECK_EQUAL(mo->getMetadataMap().at(publicationKey), "2000");
+  BOOST_CHECK_EQUAL(mo->getMetadataMap().at(cycleKey), "2000");
+}
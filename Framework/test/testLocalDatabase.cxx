@@ -0,0 +1,210 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLocalDatabase.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/LocalDatabase.h"
+#include "QualityControl/DatabaseFactory.h"
+
+#include <TH1F.h>
+#include <TROOT.h>
+#include <filesystem>
+#include <thread>
+#include <unistd.h>
+
+#define BOOST_TEST_MODULE LocalDatabase test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct test_fixture {
+  test_fixture()
+  {
+    directory = fs::temp_directory_path() / ("qc_local_repository_" + std::to_string(getpid()));
+    fs::remove_all(directory);
+    backend.connect({ { "path", directory.string() } });
+  }
+  ~test_fixture() { fs::remove_all(directory); }
+
+  std::shared_ptr<MonitorObject> makeMO(const std::string& name, double fill)
+  {
+    auto* histo = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+    histo->Fill(fill);
+    auto mo = std::make_shared<MonitorObject>(histo, "task", "TST");
+    mo->setIsOwner(true);
+    return mo;
+  }
+
+  fs::path directory;
+  LocalDatabase backend;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(local_database_factory)
+{
+  auto database = DatabaseFactory::create("Local");
+  BOOST_CHECK(dynamic_cast<LocalDatabase*>(database.get()));
+}
+
+BOOST_AUTO_TEST_CASE(local_database_store_retrieve_mo)
+{
+  test_fixture f;
+
+  auto mo = f.makeMO("histo", 1);
+  mo->addMetadata("my_meta", "is_good");
+  f.backend.storeMO(mo, 1000, 2000);
+  f.backend.storeMO(f.makeMO("histo", 5), 1500, 3000);
+
+  // the version with the latest start of validity wins
+  auto retrieved = f.backend.retrieveMO("qc/TST/MO/task", "histo", 1200);
+  BOOST_REQUIRE(retrieved);
+  auto* histo = dynamic_cast<TH1F*>(retrieved->getObject());
+  BOOST_REQUIRE(histo);
+  BOOST_CHECK_EQUAL(histo->GetBinContent(histo->FindBin(1)), 1);
+  BOOST_CHECK_EQUAL(retrieved->getTaskName(), "task");
+  BOOST_CHECK_EQUAL(retrieved->getDetectorName(), "TST");
+  BOOST_CHECK_EQUAL(retrieved->getMetadataMap().at("my_meta"), "is_good");
+
+  retrieved = f.backend.retrieveMO("qc/TST/MO/task", "histo", 1700);
+  BOOST_REQUIRE(retrieved);
+  histo = dynamic_cast<TH1F*>(retrieved->getObject());
+  BOOST_REQUIRE(histo);
+  BOOST_CHECK_EQUAL(histo->GetBinContent(histo->FindBin(5)), 1);
+
+  // out of validity
+  BOOST_CHECK(f.backend.retrieveMO("qc/TST/MO/task", "histo", 500) == nullptr);
+  BOOST_CHECK(f.backend.retrieveMO("qc/TST/MO/task", "histo", 3000) == nullptr);
+  BOOST_CHECK(f.backend.retrieveMO("qc/TST/MO/task", "missing", 1200) == nullptr);
+
+  // metadata filter
+  std::map<std::string, std::string> headers;
+  std::unique_ptr<TObject> object(f.backend.retrieveTObject(mo->getPath(), { { "my_meta", "is_good" } }, 1700, &headers));
+  BOOST_REQUIRE(object);
+  BOOST_CHECK_EQUAL(headers.at("Valid-From"), "1000");
+  BOOST_CHECK(f.backend.retrieveTObject(mo->getPath(), { { "my_meta", "is_bad" } }, 1700) == nullptr);
+
+  BOOST_CHECK(!f.backend.retrieveJson(mo->getPath(), 1200, {}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(local_database_store_retrieve_qo)
+{
+  test_fixture f;
+
+  auto qo = std::make_shared<QualityObject>(Quality::Bad, "check", "TST", "OnAll", std::vector<std::string>{ "input" });
+  f.backend.storeQO(qo);
+
+  auto retrieved = f.backend.retrieveQO(qo->getPath());
+  BOOST_REQUIRE(retrieved);
+  BOOST_CHECK_EQUAL(retrieved->getQuality(), Quality::Bad);
+  BOOST_CHECK_EQUAL(retrieved->getCheckName(), "check");
+
+  std::map<std::string, std::string> headers;
+  auto* raw = static_cast<QualityObject*>(f.backend.retrieveAny(typeid(QualityObject), qo->getPath(), {}, -1, &headers));
+  BOOST_REQUIRE(raw);
+  BOOST_CHECK_EQUAL(headers.at("qc_check_name"), "check");
+  delete raw;
+}
+
+BOOST_AUTO_TEST_CASE(local_database_listing_timestamps_truncate)
+{
+  test_fixture f;
+
+  f.backend.storeMO(f.makeMO("histo", 1), 3000, 4000);
+  f.backend.storeMO(f.makeMO("histo", 1), 1000, 2000);
+  f.backend.storeMO(f.makeMO("path/to/histo", 1), 1000, 2000);
+
+  auto timestamps = f.backend.getTimestampsForObject("qc/TST/MO/task/histo");
+  BOOST_CHECK_EQUAL_COLLECTIONS(timestamps.begin(), timestamps.end(), std::vector<uint64_t>({ 1000, 3000 }).begin(), std::vector<uint64_t>({ 1000, 3000 }).end());
+  BOOST_CHECK(f.backend.getTimestampsForObject("qc/TST/MO/task/missing").empty());
+
+  auto listing = f.backend.getListing("qc/TST/MO");
+  BOOST_CHECK_EQUAL(listing.size(), 2);
+  BOOST_CHECK(std::find(listing.begin(), listing.end(), "qc/TST/MO/task/histo") != listing.end());
+  BOOST_CHECK(std::find(listing.begin(), listing.end(), "qc/TST/MO/task/path/to/histo") != listing.end());
+
+  auto names = f.backend.getPublishedObjectNames("qc/TST/MO/task");
+  BOOST_CHECK(std::find(names.begin(), names.end(), "/histo") != names.end());
+  BOOST_CHECK(std::find(names.begin(), names.end(), "/path/to/histo") != names.end());
+
+  // the nested object is not removed with its parent
+  f.backend.truncate("qc/TST/MO/task", "histo");
+  BOOST_CHECK(f.backend.getTimestampsForObject("qc/TST/MO/task/histo").empty());
+  BOOST_CHECK_EQUAL(f.backend.getTimestampsForObject("qc/TST/MO/task/path/to/histo").size(), 1);
+
+  f.backend.truncate("qc/TST/MO/task", "*");
+  BOOST_CHECK(f.backend.getListing("qc/TST/MO").empty());
+}
+
+BOOST_AUTO_TEST_CASE(local_database_retrieve_many)
+{
+  test_fixture f;
+
+  f.backend.storeMO(f.makeMO("histo", 1), 1000, 2000);
+  auto qo = std::make_shared<QualityObject>(Quality::Medium, "check", "TST", "OnAll", std::vector<std::string>{ "input" });
+  f.backend.storeQO(qo, 1000, 2000);
+
+  auto retrieved = f.backend.retrieveMany({ { "qc/TST/MO/task/histo", 1500 }, { "qc/TST/MO/task/missing", 1500 }, { qo->getPath(), 1500 } });
+  BOOST_REQUIRE_EQUAL(retrieved.size(), 3);
+  BOOST_CHECK(retrieved[1].object == nullptr);
+
+  auto mo = DatabaseInterface::toMonitorObject(std::move(retrieved[0]));
+  BOOST_REQUIRE(mo);
+  BOOST_CHECK(dynamic_cast<TH1F*>(mo->getObject()));
+  BOOST_CHECK_EQUAL(mo->getTaskName(), "task");
+  BOOST_CHECK(DatabaseInterface::toMonitorObject(std::move(retrieved[1])) == nullptr);
+
+  auto retrievedQO = DatabaseInterface::toQualityObject(std::move(retrieved[2]));
+  BOOST_REQUIRE(retrievedQO);
+  BOOST_CHECK_EQUAL(retrievedQO->getQuality(), Quality::Medium);
+  BOOST_CHECK_EQUAL(retrievedQO->getMetadataMap().at("Valid-From"), "1000");
+}
+
+BOOST_AUTO_TEST_CASE(local_database_concurrent_versions)
+{
+  ROOT::EnableThreadSafety();
+  test_fixture f;
+
+  // the versions stored in the same millisecond by several threads are all kept
+  constexpr int nThreads = 4;
+  constexpr int nVersions = 20;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; i++) {
+    threads.emplace_back([&f]() {
+      LocalDatabase backend;
+      backend.connect({ { "path", f.directory.string() } });
+      for (int version = 0; version < nVersions; version++) {
+        backend.storeMO(f.makeMO("histo", version), 1000, 2000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  size_t files = 0;
+  for (const auto& entry : fs::directory_iterator(f.directory / "qc/TST/MO/task/histo")) {
+    BOOST_CHECK_EQUAL(entry.path().extension().string(), ".root");
+    files++;
+  }
+  BOOST_CHECK_EQUAL(files, nThreads * nVersions);
+  BOOST_CHECK(f.backend.retrieveMO("qc/TST/MO/task", "histo", 1500) != nullptr);
+}
@@ -149,4 +149,86 @@ BOOST_AUTO_TEST_CASE(drawOptions_test)
   BOOST_CHECK_EQUAL(objectsManager.getMonitorObject("histo")->getMetadataMap().at(ObjectsManager::gDisplayHintsKey), "gridy logy");
 }
 
+BOOST_AUTO_TEST_CASE(modified_objects_test)
+{
+  TaskConfig config;
+  config.taskName = "test";
+  ObjectsManager objectsManager(config.taskName, config.detectorName, config.consulUrl, 0, true);
+
+  TObjString s("content");
+  TH1F h1("histo1", "h", 100, 0, 99);
+  TH1F h2("histo2", "h", 100, 0, 99);
+  objectsManager.startPublishing(&s);
+  objectsManager.startPublishing(&h1);
+  objectsManager.startPublishing(&h2);
+
+  // everything is new at the beginning
+  std::unique_ptr<TObjArray> array(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 3);
+
+  // objects which are not histograms are always sent
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("content") != nullptr);
+
+  h1.Fill(5);
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+
+  objectsManager.setDisplayHint("histo2", "logy");
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo2") != nullptr);
+
+  // resetting is a modification, unless it is acknowledged
+  h1.Reset();
+  h2.Fill(3);
+  h2.Reset();
+  objectsManager.markAllAsUnmodified();
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+
+  // deleting the array does not delete the objects
+  array.reset();
+  BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("histo1"));
+}
+
+BOOST_AUTO_TEST_CASE(modified_objects_keep_alive_test)
+{
+  TaskConfig config;
+  config.taskName = "test";
+  ObjectsManager objectsManager(config.taskName, config.detectorName, config.consulUrl, 0, true);
+
+  TH1F h1("histo1", "h", 100, 0, 99);
+  TH1F h2("histo2", "h", 100, 0, 99);
+  objectsManager.startPublishing(&h1);
+  objectsManager.startPublishing(&h2);
+
+  std::unique_ptr<TObjArray> array(objectsManager.getNonOwningArrayOfModified(3));
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+
+  // unmodified objects are sent again after 3 calls without them
+  for (int i = 0; i < 2; i++) {
+    h1.Fill(5);
+    array.reset(objectsManager.getNonOwningArrayOfModified(3));
+    BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+    BOOST_CHECK(array->FindObject("histo1") != nullptr);
+  }
+  array.reset(objectsManager.getNonOwningArrayOfModified(3));
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("histo2") != nullptr);
+
+  // the count starts again after each publication
+  array.reset(objectsManager.getNonOwningArrayOfModified(3));
+  BOOST_CHECK_EQUAL(array->GetEntries(), 0);
+  array.reset(objectsManager.getNonOwningArrayOfModified(3));
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+
+  // without keep-alive, they are never sent again
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 0);
+}
+
 } // namespace o2::quality_control::core
@@ -362,3 +362,31 @@ BOOST_AUTO_TEST_CASE(test_errors)
   BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor2"), false);
   updatePolicyManager.updateGlobalRevision();
 }
+
+BOOST_AUTO_TEST_CASE(test_objects_received_before_policy)
+{
+  UpdatePolicyManager updatePolicyManager;
+
+  updatePolicyManager.updateObjectRevision("object1");
+  updatePolicyManager.updateGlobalRevision();
+
+  // the policies are aware of what was received before they were added
+  updatePolicyManager.addPolicy("actor1", "OnAnyNonZero", { "object1", "object2" }, false, false);
+  updatePolicyManager.addPolicy("actor2", "OnAll", { "object1", "object2" }, false, false);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor1"), false);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor2"), false);
+
+  updatePolicyManager.updateObjectRevision("object2");
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor1"), true);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor2"), true);
+  updatePolicyManager.updateActorRevision("actor1");
+  updatePolicyManager.updateActorRevision("actor2");
+  updatePolicyManager.updateGlobalRevision();
+
+  // an explicit older revision of an actor makes the objects received since then updated again
+  updatePolicyManager.updateActorRevision("actor2", 1);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor1"), false);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor2"), false);
+  updatePolicyManager.updateActorRevision("actor2", 0);
+  BOOST_CHECK_EQUAL(updatePolicyManager.isReady("actor2"), true);
+}
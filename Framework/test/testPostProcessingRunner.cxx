@@ -36,4 +36,18 @@ BOOST_AUTO_TEST_CASE(test_factory)
   // todo: this initializes database. should we have an option not to do it, so we don't fail test randomly?
   BOOST_CHECK_NO_THROW(runner.init(config->getRecursive()));
   BOOST_CHECK_NO_THROW(runner.run());
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_check_trigger_outside_workflow)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  auto config = ConfigurationFactory::getConfiguration(configFilePath)->getRecursive();
+  auto& initTriggers = config.get_child("qc.postprocessing.SkeletonPostProcessing.initTrigger");
+  initTriggers.clear();
+  initTriggers.push_back({ "", boost::property_tree::ptree("newobject:check:QcCheck") });
+
+  // without a QC workflow, nothing would deliver the results of the Check
+  PostProcessingRunner runner("SkeletonPostProcessing");
+  BOOST_REQUIRE_NO_THROW(runner.init(config));
+  BOOST_CHECK_THROW(runner.start(), std::invalid_argument);
+}
@@ -0,0 +1,104 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testRetrievalCache.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/RetrievalCache.h"
+
+#include <TH1F.h>
+
+#define BOOST_TEST_MODULE RetrievalCache test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::repository;
+
+namespace
+{
+std::unique_ptr<RetrievalCache::Entry> makeEntry(const std::string& etag, long validFrom, long validUntil, size_t bytes)
+{
+  auto entry = std::make_unique<RetrievalCache::Entry>();
+  auto* histo = new TH1F(etag.c_str(), etag.c_str(), 10, 0, 10);
+  histo->SetDirectory(nullptr);
+  entry->object.reset(histo);
+  entry->headers = { { "ETag", etag } };
+  entry->etag = etag;
+  entry->validFrom = validFrom;
+  entry->validUntil = validUntil;
+  entry->bytes = bytes;
+  return entry;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(retrieval_cache_find)
+{
+  RetrievalCache cache(1000);
+  cache.insert("qc/TST/MO/task/histo", {}, makeEntry("a", 1000, 2000, 10));
+  cache.insert("qc/TST/MO/task/histo", {}, makeEntry("b", 1500, 3000, 10));
+  cache.insert("qc/TST/MO/task/histo", { { "run", "1" } }, makeEntry("c", 1000, 3000, 10));
+
+  // the version with the latest start of validity wins
+  auto* entry = cache.find("qc/TST/MO/task/histo", {}, 1200);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->etag, "a");
+  BOOST_CHECK_EQUAL(entry->object->GetName(), std::string("a"));
+  entry = cache.find("qc/TST/MO/task/histo", {}, 1700);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->etag, "b");
+  entry = cache.find("qc/TST/MO/task/histo", { { "run", "1" } }, 1200);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->etag, "c");
+
+  BOOST_CHECK(cache.find("qc/TST/MO/task/histo", {}, 500) == nullptr);
+  BOOST_CHECK(cache.find("qc/TST/MO/task/histo", {}, 3000) == nullptr);
+  BOOST_CHECK(cache.find("qc/TST/MO/task/histo", { { "run", "2" } }, 1200) == nullptr);
+  BOOST_CHECK(cache.find("qc/TST/MO/task/missing", {}, 1200) == nullptr);
+
+  // a version with the same start of validity is replaced
+  cache.insert("qc/TST/MO/task/histo", {}, makeEntry("d", 1500, 3000, 20));
+  entry = cache.find("qc/TST/MO/task/histo", {}, 1700);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->etag, "d");
+  BOOST_CHECK_EQUAL(cache.getStatistics().entries, 3);
+  BOOST_CHECK_EQUAL(cache.getStatistics().bytes, 40);
+}
+
+BOOST_AUTO_TEST_CASE(retrieval_cache_eviction)
+{
+  RetrievalCache cache(100);
+  cache.insert("a", {}, makeEntry("a", 0, 10, 40));
+  cache.insert("b", {}, makeEntry("b", 0, 10, 40));
+  // "a" becomes the most recently used, so that "b" is evicted first
+  BOOST_CHECK(cache.find("a", {}, 5));
+  cache.insert("c", {}, makeEntry("c", 0, 10, 40));
+
+  BOOST_CHECK(cache.find("a", {}, 5));
+  BOOST_CHECK(cache.find("b", {}, 5) == nullptr);
+  BOOST_CHECK(cache.find("c", {}, 5));
+  BOOST_CHECK_EQUAL(cache.getStatistics().evictions, 1);
+  BOOST_CHECK_EQUAL(cache.getStatistics().entries, 2);
+  BOOST_CHECK_EQUAL(cache.getStatistics().bytes, 80);
+
+  // larger than the budget
+  cache.insert("d", {}, makeEntry("d", 0, 10, 101));
+  BOOST_CHECK(cache.find("d", {}, 5) == nullptr);
+  BOOST_CHECK_EQUAL(cache.getStatistics().entries, 2);
+
+  cache.recordHit();
+  cache.recordMiss();
+  cache.recordMiss();
+  BOOST_CHECK_EQUAL(cache.getStatistics().hits, 1);
+  BOOST_CHECK_EQUAL(cache.getStatistics().misses, 2);
+}
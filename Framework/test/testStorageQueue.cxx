@@ -0,0 +1,158 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testStorageQueue.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/StorageQueue.h"
+#include "QualityControl/DummyDatabase.h"
+#include <TH1F.h>
+
+#include <atomic>
+#include <future>
+
+#define BOOST_TEST_MODULE StorageQueue test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+struct Counters {
+  std::atomic<int> mos = 0;
+  std::atomic<int> qos = 0;
+  std::atomic<int> connections = 0;
+  std::atomic<int> started = 0;
+};
+
+// Counts what is stored. It can block the storage until released, to simulate a slow repository.
+class CountingDatabase : public DummyDatabase
+{
+ public:
+  CountingDatabase(Counters& counters, std::shared_future<void> release = {}) : mCounters(counters), mRelease(release)
+  {
+    mCounters.connections++;
+  }
+  void storeMO(std::shared_ptr<const MonitorObject>, long, long) override
+  {
+    wait();
+    mCounters.mos++;
+  }
+  void storeQO(std::shared_ptr<const QualityObject>, long, long) override
+  {
+    wait();
+    mCounters.qos++;
+  }
+
+ private:
+  void wait()
+  {
+    mCounters.started++;
+    if (mRelease.valid()) {
+      mRelease.wait();
+    }
+  }
+  Counters& mCounters;
+  std::shared_future<void> mRelease;
+};
+
+std::shared_ptr<MonitorObject> makeMO(const std::string& name)
+{
+  auto mo = std::make_shared<MonitorObject>(new TH1F(name.c_str(), name.c_str(), 10, 0, 10), "task", "TST");
+  mo->setIsOwner(true);
+  return mo;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_storage_queue_stores_everything)
+{
+  Counters counters;
+  {
+    StorageQueue queue([&]() { return std::make_unique<CountingDatabase>(counters); }, { 3, 100, 4 });
+    BOOST_CHECK_EQUAL(counters.connections, 3);
+
+    for (int i = 0; i < 50; i++) {
+      BOOST_CHECK(queue.push(makeMO("histo" + std::to_string(i))));
+    }
+    auto qo = std::make_shared<QualityObject>(Quality::Good, "check", "TST");
+    qo->addMetadata(latency_tracing::cycleEndKey, std::to_string(latency_tracing::now() - 1000));
+    BOOST_CHECK(queue.push(qo));
+    queue.flush();
+
+    BOOST_CHECK_EQUAL(counters.mos, 50);
+    BOOST_CHECK_EQUAL(counters.qos, 1);
+    auto statistics = queue.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.pushed, 51);
+    BOOST_CHECK_EQUAL(statistics.storedMOs, 50);
+    BOOST_CHECK_EQUAL(statistics.storedQOs, 1);
+    BOOST_CHECK_EQUAL(statistics.dropped, 0);
+    BOOST_CHECK_EQUAL(statistics.failed, 0);
+    BOOST_CHECK_EQUAL(statistics.pending, 0);
+
+    // the latency of the QO is measured once it is stored
+    auto latency = queue.popStorageLatency();
+    BOOST_REQUIRE_EQUAL(latency.size(), 1);
+    BOOST_CHECK_GE(latency.getQuantile(0.5), 1.0);
+    BOOST_CHECK(queue.popStorageLatency().empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_storage_queue_coalesce_and_drop)
+{
+  Counters counters;
+  std::promise<void> release;
+  std::shared_future<void> releaseFuture = release.get_future().share();
+  {
+    StorageQueue queue([&]() { return std::make_unique<CountingDatabase>(counters, releaseFuture); }, { 1, 2, 1 });
+
+    // the only worker takes the first object and gets blocked by the "slow" repository
+    BOOST_CHECK(queue.push(makeMO("blocking")));
+    while (counters.started == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    BOOST_CHECK(queue.push(makeMO("histo1")));
+    BOOST_CHECK(queue.push(makeMO("histo2")));
+    // same path as a waiting object, it replaces it
+    BOOST_CHECK(queue.push(makeMO("histo1")));
+    // the queue is full
+    BOOST_CHECK(!queue.push(makeMO("histo3")));
+
+    release.set_value();
+    queue.flush();
+
+    BOOST_CHECK_EQUAL(counters.mos, 3);
+    auto statistics = queue.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.pushed, 4);
+    BOOST_CHECK_EQUAL(statistics.coalesced, 1);
+    BOOST_CHECK_EQUAL(statistics.dropped, 1);
+    BOOST_CHECK_EQUAL(statistics.storedMOs, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_storage_queue_stores_remaining_on_destruction)
+{
+  Counters counters;
+  {
+    StorageQueue queue([&]() { return std::make_unique<CountingDatabase>(counters); }, { 2, 1000, 10 });
+    for (int i = 0; i < 100; i++) {
+      queue.push(makeMO("histo" + std::to_string(i)));
+    }
+  }
+  BOOST_CHECK_EQUAL(counters.mos, 100);
+}
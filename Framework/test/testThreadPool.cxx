@@ -0,0 +1,67 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testThreadPool.cxx
+/// \author Piotr Konopka
+///
+
+#include "QualityControl/ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE ThreadPool test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+
+BOOST_AUTO_TEST_CASE(test_thread_pool_runs_jobs_concurrently)
+{
+  ThreadPool pool(2);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  // the first job can finish only if the second one is executed at the same time
+  std::promise<void> secondStarted;
+  auto first = pool.submit([started = secondStarted.get_future().share()]() {
+    if (started.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+      throw std::runtime_error("the jobs were not executed concurrently");
+    }
+  });
+  auto second = pool.submit([&]() { secondStarted.set_value(); });
+
+  BOOST_CHECK_NO_THROW(first.get());
+  BOOST_CHECK_NO_THROW(second.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_pool_exceptions)
+{
+  ThreadPool pool(1);
+  auto failing = pool.submit([]() { throw std::runtime_error("failure"); });
+  auto succeeding = pool.submit([]() {});
+
+  BOOST_CHECK_THROW(failing.get(), std::runtime_error);
+  BOOST_CHECK_NO_THROW(succeeding.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_pool_finishes_jobs_on_destruction)
+{
+  std::atomic<int> executed = 0;
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 100; i++) {
+      pool.submit([&]() { executed++; });
+    }
+  }
+  BOOST_CHECK_EQUAL(executed, 100);
+}
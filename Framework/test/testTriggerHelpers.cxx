@@ -81,6 +81,14 @@ BOOST_AUTO_TEST_CASE(test_factory)
   BOOST_CHECK_THROW(trigger_helpers::triggerFactory("newobject:nodb:qc/incorrect/db/speficied", configWithDBs), std::invalid_argument);
   BOOST_CHECK_THROW(trigger_helpers::triggerFactory("newobject:ccdb:qc/too:many tokens", configWithDBs), std::invalid_argument);
 
+  // new objects from the QC workflow
+  auto notifications = std::make_shared<ObjectNotifications>();
+  BOOST_CHECK_NO_THROW(trigger_helpers::triggerFactory("newobject:check:MyCheck", dummyConfig, notifications));
+  BOOST_CHECK_NO_THROW(trigger_helpers::triggerFactory("NewObject:Check:MyCheck", dummyConfig, notifications));
+  BOOST_CHECK_THROW(trigger_helpers::triggerFactory("newobject:check:", dummyConfig, notifications), std::invalid_argument);
+  // not in a QC workflow
+  BOOST_CHECK_THROW(trigger_helpers::triggerFactory("newobject:check:MyCheck", dummyConfig), std::invalid_argument);
+
   // fixme: this is treated as "123 seconds", do we want to be so defensive?
   BOOST_CHECK_NO_THROW(trigger_helpers::triggerFactory("123 secure code", dummyConfig));
 }
@@ -123,4 +131,22 @@ BOOST_AUTO_TEST_CASE(test_try_triggers)
     BOOST_CHECK(!trigger_helpers::tryTrigger(triggers));
     BOOST_CHECK(!trigger_helpers::tryTrigger(triggers));
   }
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_check_names_in_triggers)
+{
+  auto checkNames = trigger_helpers::getCheckNamesInTriggers({ "once", "newobject:check:CheckA", "NewObject:Check:CheckB", "newobject:qcdb:qc/TST/MO/Task/obj", "newobject:check:CheckA" });
+  BOOST_REQUIRE_EQUAL(checkNames.size(), 2);
+  BOOST_CHECK_EQUAL(checkNames[0], "CheckA");
+  BOOST_CHECK_EQUAL(checkNames[1], "CheckB");
+
+  PostProcessingConfig dummyConfig;
+  auto notifications = std::make_shared<ObjectNotifications>();
+  auto triggers = trigger_helpers::createTriggers({ "newobject:check:CheckA" }, dummyConfig, notifications);
+  BOOST_CHECK(!trigger_helpers::tryTrigger(triggers));
+  notifications->notify("CheckA", 1000);
+  auto trigger = trigger_helpers::tryTrigger(triggers);
+  BOOST_CHECK_EQUAL(trigger.triggerType, TriggerType::NewObject);
+  BOOST_CHECK_EQUAL(trigger.timestamp, 1000);
+  BOOST_CHECK(!trigger_helpers::tryTrigger(triggers));
+}
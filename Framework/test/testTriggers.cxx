@@ -121,4 +121,27 @@ BOOST_AUTO_TEST_CASE(test_trigger_new_object)
   directDBAPI->init(CCDB_ENDPOINT);
   BOOST_REQUIRE(directDBAPI->isHostReachable());
   directDBAPI->truncate(objectPath);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_trigger_new_object_in_workflow)
+{
+  auto notifications = std::make_shared<ObjectNotifications>();
+  // notifications which came before the trigger was created are not taken into account
+  notifications->notify("checkA", 100);
+  auto trigger = triggers::NewObjectInWorkflow(notifications, "checkA");
+  auto otherTrigger = triggers::NewObjectInWorkflow(notifications, "checkB");
+  BOOST_CHECK_EQUAL(trigger(), TriggerType::No);
+
+  notifications->notify("checkA", 200);
+  notifications->notify("checkA", 300);
+  // several notifications result in one trigger with the latest timestamp
+  auto result = trigger();
+  BOOST_CHECK_EQUAL(result.triggerType, TriggerType::NewObject);
+  BOOST_CHECK_EQUAL(result.timestamp, 300);
+  BOOST_CHECK_EQUAL(trigger(), TriggerType::No);
+  BOOST_CHECK_EQUAL(otherTrigger(), TriggerType::No);
+
+  notifications->notify("checkB", 400);
+  BOOST_CHECK_EQUAL(trigger(), TriggerType::No);
+  BOOST_CHECK_EQUAL(otherTrigger(), TriggerType::NewObject);
+  BOOST_CHECK_EQUAL(otherTrigger(), TriggerType::No);
+}
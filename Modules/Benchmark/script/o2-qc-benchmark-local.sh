@@ -0,0 +1,280 @@
+#!/usr/bin/env bash
+
+#set -e ;# exit on error
+set -u ;# exit when using undeclared variable
+#set -x ;# debugging
+
+trap kill_benchmark INT
+
+function check_installed() {
+  # very stupid but easy way to check if a package is installed
+  $1 --version > /dev/null
+  if [ $? -ne 0 ]; then
+    echo "Please install the package "$1" before running the benchmark."
+    exit 1;
+  fi
+}
+
+echo 'Checking if all necessary packages are installed...'
+check_installed awk
+check_installed pkill
+check_installed ps
+check_installed sed
+check_installed grep
+check_installed timeout
+echo '...all are there.'
+
+function kill_benchmark() {
+  echo "Killing any running benchmark workflows..."
+  pkill -9 -f 'o2-qc '
+  pkill -9 -f 'o2-qc-run-producer'
+  exit 1
+}
+
+function inplace_sed() {
+  sed -ibck "$1" $2 && rm $2bck
+}
+
+# Prints the values of a field of a metric found in the log, skipping the warm up cycles
+# \param 1 : log file
+# \param 2 : metric name
+# \param 3 : field name
+# \param 4 : warm up cycles
+function metric_values() {
+  grep -a "$2" $1 | grep -o -e "$3"'=[0-9.eE+-]\{1,\}' | sed -e 's/'"$3"'=//' | tail -n +$(($4 + 1))
+}
+
+# Runs the command in its own session and prints the peak of the total resident memory of its processes in kB
+# \param 1 : command
+# \param 2 : test duration
+# \param 3 : log file
+function run_and_measure_rss() {
+  setsid timeout -k 5s $2 bash -c "$1" > $3 2>&1 &
+  local session=$!
+  local peak_rss=0
+  while kill -0 $session 2> /dev/null; do
+    local rss=$(ps -o rss= -s $session | awk '{ sum += $1 } END { print sum + 0 }')
+    if [ $rss -gt $peak_rss ]; then
+      peak_rss=$rss
+    fi
+    sleep 1
+  done
+  wait $session
+  echo $peak_rss
+}
+
+# Runs all the combinations of the parameters and appends one line per repetition to the report
+# \param 1 : report file
+function benchmark() {
+  local report=$1
+  local config_file_template='../etc/benchmarkCheckTemplate.json'
+  local config_file_concrete='benchmarkLocal.json'
+  local run_log='run_log'
+  local check_config='\"AlwaysGoodCheck__CHECK_NO__\":{\"active\":\"true\",\"className\":\"o2::quality_control_modules::benchmark::AlwaysGoodCheck\",\"moduleName\":\"QcBenchmark\",\"policy\":\"OnAny\",\"detectorName\":\"TST\",\"dataSource\":[{\"type\":\"Task\",\"name\":\"BenchmarkTask\"}]},__CHECKS__'
+  local repo_latest_commit=$(git rev-parse --short HEAD 2> /dev/null || echo unknown)
+
+  echo "commit,message_size,message_rate,nb_histograms,nb_bins,nb_checks,repetition,msgs_per_second,data_per_second,objs_published_per_second,publication_latency_s,check_latency_avg_s,check_latency_max_s,peak_rss_kb" > $report
+
+  local qc_common_args="--run -b --shm-segment-size $SHM_SEGMENT_SIZE --infologger-severity info --config json:/"`pwd`'/'$config_file_concrete
+  local producer_common_args="-b --shm-segment-size $SHM_SEGMENT_SIZE --producers 1"
+  if [[ $FILL == "no" ]]; then
+    producer_common_args=$producer_common_args' --empty'
+  fi
+
+  for message_size in ${MESSAGE_SIZES[@]}; do
+    for message_rate in ${MESSAGE_RATES[@]}; do
+      for nb_histograms in ${NB_HISTOGRAMS[@]}; do
+        for nb_bins in ${NB_BINS[@]}; do
+          for nb_checks in ${NB_CHECKS[@]}; do
+            echo "************************************************************"
+            echo "Launching the test for $message_size bytes at $message_rate Hz, $nb_histograms histograms, $nb_bins bins, $nb_checks checks"
+
+            rm -f $config_file_concrete
+            # the consul url is emptied, so that the benchmark does not depend on any remote service discovery
+            sed 's/__CYCLE_SECONDS__/'$CYCLE_SECONDS'/; s/__NUMBER_OF_HISTOGRAMS__/'$nb_histograms'/; s/__NUMBER_OF_BINS__/'$nb_bins'/; s|"url" : "http://consul-test.cern.ch:8500"|"url" : ""|' $config_file_template > $config_file_concrete
+            for ((check_no=0;check_no<nb_checks;check_no++)); do
+              new_check=`echo ${check_config} | sed 's/__CHECK_NO__/'$check_no'/g'`
+              inplace_sed 's/__CHECKS__/\n'$new_check'/g' $config_file_concrete
+            done
+            # cut last comma and tag
+            inplace_sed 's/,__CHECKS__//g' $config_file_concrete
+
+            command_producer="o2-qc-run-producer "$producer_common_args" --min-size "$message_size" --max-size "$message_size" --message-rate "$message_rate
+            command_qc="o2-qc "$qc_common_args
+            command=$command_producer" | "$command_qc
+            echo "Used command: $command"
+
+            for ((rep=0;rep<REPETITIONS;rep++)); do
+              echo "Repetition: "$rep
+
+              peak_rss=$(run_and_measure_rss "$command" $TEST_DURATION $run_log)
+
+              # Cleaning up potentially leftover processes. Notice the space after o2-qc to avoid suicide
+              pkill -9 -f 'o2-qc '
+              pkill -9 -f 'o2-qc-run-producer'
+
+              if grep -q 'ERROR\|segmentation violation' $run_log; then
+                echo 'Error in the test:'
+                echo `grep 'ERROR\|segmentation' $run_log`
+                mv $run_log run_log_error_"$(date +"%y-%m-%d-%H:%M:%S")"
+                printf "%s,%s,%s,%s,%s,%s,%s,,,,,,,%s\n" "$repo_latest_commit" "$message_size" "$message_rate" "$nb_histograms" "$nb_bins" "$nb_checks" "$rep" "$peak_rss" >> $report
+                continue
+              fi
+
+              # the sums of the cycles after the warm up give the average rates
+              local totals=$(paste -d ' ' \
+                <(metric_values $run_log 'qc_data_received' 'messages_in_cycle' $WARM_UP_CYCLES) \
+                <(metric_values $run_log 'qc_data_received' 'data_in_cycle' $WARM_UP_CYCLES) \
+                <(metric_values $run_log 'qc_objects_published' 'in_cycle' $WARM_UP_CYCLES) \
+                <(metric_values $run_log 'qc_duration' 'module_cycle' $WARM_UP_CYCLES) \
+                <(metric_values $run_log 'qc_duration' 'publication' $WARM_UP_CYCLES) |
+                awk 'NF == 5 { m += $1; d += $2; o += $3; t += $4 + $5; p += $5; n++ }
+                     END { if (n > 0 && t > 0) printf "%.3f,%.3f,%.3f,%.6f", m / t, d / t, o / t, p / n; else printf ",,," }')
+              local check_latency=$(paste -d ' ' \
+                <(metric_values $run_log 'qc_checks_duration' 'average' 0) \
+                <(metric_values $run_log 'qc_checks_duration' 'max' 0) |
+                awk 'NF == 2 { a += $1; if ($2 > m) m = $2; n++ }
+                     END { if (n > 0) printf "%.6f,%.6f", a / n, m; else printf "," }')
+
+              printf "%s,%s,%s,%s,%s,%s,%s,%s,%s,%s\n" "$repo_latest_commit" "$message_size" "$message_rate" "$nb_histograms" "$nb_bins" "$nb_checks" "$rep" "$totals" "$check_latency" "$peak_rss" >> $report
+            done
+          done
+        done
+      done
+    done
+  done
+
+  # cleanups
+  rm -f $config_file_concrete
+  rm -f $run_log
+}
+
+# Compares the average message rates of the report with the ones of a baseline report for the same parameters
+# \param 1 : report file
+# \param 2 : baseline report file
+# \param 3 : accepted relative decrease
+# \return 1 if any combination of parameters is slower than accepted
+function compare_with_baseline() {
+  awk -F ',' -v tolerance=$3 '
+    FNR == 1 { next }
+    $8 == "" { next }
+    { key = $2 "," $3 "," $4 "," $5 "," $6 }
+    NR == FNR { baseline[key] += $8; baseline_n[key]++; next }
+    { current[key] += $8; current_n[key]++ }
+    END {
+      failed = 0
+      for (key in current) {
+        if (!(key in baseline)) {
+          continue
+        }
+        reference = baseline[key] / baseline_n[key]
+        measured = current[key] / current_n[key]
+        status = measured < reference * (1 - tolerance) ? "REGRESSION" : "ok"
+        if (status == "REGRESSION") {
+          failed = 1
+        }
+        printf "%-10s %s: %.3f msgs/s (baseline %.3f)\n", status, key, measured, reference
+      }
+      exit failed
+    }' $2 $1
+}
+
+function print_usage() {
+  echo "Usage: ./o2-qc-benchmark-local.sh [-f] [-s SIZES] [-r RATES] [-H HISTOGRAMS] [-B BINS] [-c CHECKS]
+                                   [-n REPETITIONS] [-d DURATION] [-o REPORT] [-b BASELINE] [-x TOLERANCE]
+
+Run a QC benchmark on this machine only: a data producer, the TH1FTask and a CheckRunner with AlwaysGoodChecks, with
+the Dummy repository. Each combination of the parameters is run and the results are written to a CSV report, with
+one line per repetition. Execute from within the same directory, after having entered the QualityControl environment.
+
+Options:
+ -h               Print this message
+ -f               Fill the produced messages. It slows down producers, but prevents from overcommitting memory.
+ -s SIZES         Message sizes in bytes, e.g. \"256 65536\" (default: \"$MESSAGE_SIZES_DEFAULT\")
+ -r RATES         Message rates in Hz (default: \"$MESSAGE_RATES_DEFAULT\")
+ -H HISTOGRAMS    Numbers of histograms of the task (default: \"$NB_HISTOGRAMS_DEFAULT\")
+ -B BINS          Numbers of bins of the histograms (default: \"$NB_BINS_DEFAULT\")
+ -c CHECKS        Numbers of checks in the CheckRunner (default: \"$NB_CHECKS_DEFAULT\")
+ -n REPETITIONS   Repetitions of each combination (default: $REPETITIONS)
+ -d DURATION      Duration of each repetition in seconds (default: $TEST_DURATION)
+ -o REPORT        Report file (default: qc-local-benchmark-<date>.csv)
+ -b BASELINE      Report of a previous run. The script fails if a message rate became lower than in the baseline.
+ -x TOLERANCE     Accepted relative decrease of the message rates with respect to the baseline (default: $TOLERANCE)
+"
+}
+
+MESSAGE_SIZES_DEFAULT="1024 1048576"
+MESSAGE_RATES_DEFAULT="100"
+NB_HISTOGRAMS_DEFAULT="1 100"
+NB_BINS_DEFAULT="1000"
+NB_CHECKS_DEFAULT="1 10"
+
+MESSAGE_SIZES=($MESSAGE_SIZES_DEFAULT)
+MESSAGE_RATES=($MESSAGE_RATES_DEFAULT)
+NB_HISTOGRAMS=($NB_HISTOGRAMS_DEFAULT)
+NB_BINS=($NB_BINS_DEFAULT)
+NB_CHECKS=($NB_CHECKS_DEFAULT)
+REPETITIONS=1
+TEST_DURATION=60
+CYCLE_SECONDS=5
+WARM_UP_CYCLES=2
+SHM_SEGMENT_SIZE=4000000000
+FILL=no
+REPORT='qc-local-benchmark-'$(date +"%y-%m-%d_%H%M")'.csv'
+BASELINE=
+TOLERANCE=0.1
+
+while getopts 'hfs:r:H:B:c:n:d:o:b:x:' option; do
+  case "${option}" in
+  \?)
+    print_usage
+    exit 1
+    ;;
+  h)
+    print_usage
+    exit 0
+    ;;
+  f)
+    FILL=yes
+    ;;
+  s)
+    MESSAGE_SIZES=($OPTARG)
+    ;;
+  r)
+    MESSAGE_RATES=($OPTARG)
+    ;;
+  H)
+    NB_HISTOGRAMS=($OPTARG)
+    ;;
+  B)
+    NB_BINS=($OPTARG)
+    ;;
+  c)
+    NB_CHECKS=($OPTARG)
+    ;;
+  n)
+    REPETITIONS=$OPTARG
+    ;;
+  d)
+    TEST_DURATION=$OPTARG
+    ;;
+  o)
+    REPORT=$OPTARG
+    ;;
+  b)
+    BASELINE=$OPTARG
+    ;;
+  x)
+    TOLERANCE=$OPTARG
+    ;;
+  esac
+done
+
+benchmark $REPORT
+echo "The results were written to $REPORT"
+
+if [ -n "$BASELINE" ]; then
+  echo "Comparing with $BASELINE..."
+  compare_with_baseline $REPORT $BASELINE $TOLERANCE
+  exit $?
+fi
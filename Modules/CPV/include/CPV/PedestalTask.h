@@ -17,8 +17,11 @@
 #define QC_MODULE_CPV_CPVPEDESTALTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/ThreadPool.h"
 #include <memory>
 #include <array>
+#include <cstdint>
+#include <vector>
 #include "DataFormatsCPV/Digit.h"
 #include "DataFormatsCPV/TriggerRecord.h"
 #include <gsl/span>
@@ -26,6 +29,8 @@
 
 class TH1F;
 class TH2F;
+class TF1;
+class TSpectrum;
 
 using namespace o2::quality_control::core;
 
@@ -51,12 +56,32 @@ class PedestalTask final : public TaskInterface
   void endOfActivity(Activity& activity) override;
   void reset() override;
 
+  /// \brief Adds the digits of an input to the amplitude spectra, as done by monitorData().
+  /// Each trigger record with digits is counted as a pedestal event.
+  void processDigits(const gsl::span<const o2::cpv::Digit>& digits, const gsl::span<const o2::cpv::TriggerRecord>& triggerRecords);
+
  private:
   void initHistograms();
   // void fillHistograms(const gsl::span<const o2::cpv::Digit>& digits, const gsl::span<const o2::cpv::TriggerRecord>& triggerRecords);
   void fillHistograms();
   void resetHistograms();
 
+  /// Pedestal of a channel, as found by computePedestal()
+  struct ChannelPedestal {
+    int numberOfPeaks = 0; ///< number of pedestal peaks, normally 1, otherwise the channel is bad
+    float value = 0;       ///< pedestal value, negative for bad channels
+    float sigma = 0;       ///< pedestal sigma
+  };
+  /// \brief Finds the pedestal peaks of the channel and fits them if there is only one.
+  /// It only reads the members of the task (apart from the amplitude spectrum of the channel), so that it can be
+  /// called concurrently for different channels, with one TSpectrum, TF1 and scratch histogram per thread.
+  /// The scratch histogram receives the compact spectrum of the channel in the compact mode.
+  ChannelPedestal computePedestal(int channel, TSpectrum& peakSearcher, TF1& functionGaus, TH1F& scratch);
+  void addAmplitude(int channel, float amplitude);
+  void resetAmplitudeStatistics(int channel);
+  /// Copies the compact spectrum of the channel into a histogram with kNCompactBins bins
+  void fillFromCompactSpectrum(int channel, TH1F& histogram) const;
+
   static constexpr short kNHist1D = 14;
   enum Histos1D { H1DInputPayloadSize,
                   H1DNInputs,
@@ -105,6 +130,20 @@ class PedestalTask final : public TaskInterface
 
   std::array<TH1F*, kNChannels> mHistAmplitudes = { nullptr };  ///< Array of amplitude spectra
   std::array<bool, kNChannels> mIsUpdatedAmplitude = { false }; ///< Array of isUpdatedAmplitude bools
+
+  // Amplitude statistics of the channels, as a structure of arrays. The sums are exact for integer ADC amplitudes.
+  std::array<unsigned int, kNChannels> mNAmplitudes = { 0 }; ///< number of amplitudes per channel
+  std::array<double, kNChannels> mAmplitudeSum = { 0. };     ///< sum of the amplitudes per channel
+  std::array<double, kNChannels> mAmplitudeSum2 = { 0. };    ///< sum of the squared amplitudes per channel
+
+  // In the compact mode, the amplitude spectra are kept in mCompactSpectra instead of mHistAmplitudes, with one
+  // bin per ADC count up to kNCompactBins, which covers the pedestals. A TH1F is created only for the bad channels.
+  static constexpr int kNCompactBins = 512;
+  bool mCompactMode = false;
+  std::vector<uint16_t> mCompactSpectra; ///< kNCompactBins counts per channel, empty if not in the compact mode
+
+  float mFastPathMaxSigma = 0.;         ///< lower spread of amplitudes to skip the peak search and the fit, 0 disables it
+  std::unique_ptr<ThreadPool> mFitPool; ///< fits the channels in parallel if more than one thread is configured
 };
 
 } // namespace o2::quality_control_modules::cpv
@@ -18,12 +18,21 @@
 #include <TH2.h>
 #include <TF1.h>
 #include <TSpectrum.h>
+#include <TROOT.h>
+#include <Math/MinimizerOptions.h>
 
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/ThreadPool.h"
 #include "CPV/PedestalTask.h"
 #include <Framework/InputRecord.h>
 #include "DataFormatsCPV/TriggerRecord.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <future>
+
 namespace o2::quality_control_modules::cpv
 {
 
@@ -54,8 +63,24 @@ void PedestalTask::initialize(o2::framework::InitContext& /*ctx*/)
   ILOG(Info, Support) << "initialize PedestalTask" << ENDM; // QcInfoLogger is used. FairMQ logs will go to there as well.
 
   // this is how to get access to custom parameters defined in the config file at qc.tasks.<task_name>.taskParameters
-  if (auto param = mCustomParameters.find("myOwnKey"); param != mCustomParameters.end()) {
-    ILOG(Info, Devel) << "Custom parameter - myOwnKey: " << param->second << ENDM;
+  if (auto param = mCustomParameters.find("compactAmplitudes"); param != mCustomParameters.end()) {
+    mCompactMode = param->second == "true";
+    ILOG(Info, Devel) << "Custom parameter - compactAmplitudes: " << param->second << ENDM;
+  }
+  if (auto param = mCustomParameters.find("fastPathMaxSigma"); param != mCustomParameters.end()) {
+    mFastPathMaxSigma = std::stof(param->second);
+    ILOG(Info, Devel) << "Custom parameter - fastPathMaxSigma: " << mFastPathMaxSigma << ENDM;
+  }
+  if (auto param = mCustomParameters.find("fitThreads"); param != mCustomParameters.end()) {
+    auto threads = std::stoul(param->second);
+    ILOG(Info, Devel) << "Custom parameter - fitThreads: " << threads << ENDM;
+    if (threads > 1) {
+      // the amplitude spectra are searched and fitted concurrently.
+      // TMinuit is not reentrant (it uses a global instance), Minuit2 is.
+      ROOT::EnableThreadSafety();
+      ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+      mFitPool = std::make_unique<ThreadPool>(threads);
+    }
   }
   initHistograms();
   mNEventsTotal = 0;
@@ -112,27 +137,8 @@ void PedestalTask::monitorData(o2::framework::ProcessingContext& ctx)
 
   // 2. Using get("<binding>")
   auto digits = ctx.inputs().get<gsl::span<o2::cpv::Digit>>("digits");
-  mHist1D[H1DNDigitsPerInput]->Fill(digits.size());
-  for (const auto& digit : digits) {
-    mHist1D[H1DDigitIds]->Fill(digit.getAbsId());
-    short relId[3];
-    mCPVGeometry.absToRelNumbering(digit.getAbsId(), relId);
-    //reminder: relId[3]={Module, phi col, z row} where Module=2..4, phi col=0..127, z row=0..59
-    mHist2D[H2DDigitMapM2 + relId[0] - 2]->Fill(relId[1], relId[2]);
-    mHistAmplitudes[digit.getAbsId()]->Fill(digit.getAmplitude());
-    mIsUpdatedAmplitude[digit.getAbsId()] = true;
-  }
-
   auto digitsTR = ctx.inputs().get<gsl::span<o2::cpv::TriggerRecord>>("dtrigrec");
-  //mNEventsTotal += digitsTR.size();//number of events in the current input
-  for (const auto& trigRecord : digitsTR) {
-    ILOG(Info, Devel) << " monitorData() : trigger record #" << mNEventsTotal
-                      << " contains " << trigRecord.getNumberOfObjects() << " objects." << ENDM;
-    if (trigRecord.getNumberOfObjects() > 0) { //at least 1 digit -> pedestal event
-      mNEventsTotal++;
-      mNEventsFromLastFillHistogramsCall++;
-    }
-  }
+  processDigits(digits, digitsTR);
   // get the payload of a specific input, which is a char array. "random" is the binding specified in the config file.
   //   auto payload = ctx.inputs().get("random").payload;
 
@@ -160,6 +166,30 @@ void PedestalTask::monitorData(o2::framework::ProcessingContext& ctx)
   //   }
 }
 
+void PedestalTask::processDigits(const gsl::span<const o2::cpv::Digit>& digits, const gsl::span<const o2::cpv::TriggerRecord>& triggerRecords)
+{
+  mHist1D[H1DNDigitsPerInput]->Fill(digits.size());
+  for (const auto& digit : digits) {
+    mHist1D[H1DDigitIds]->Fill(digit.getAbsId());
+    short relId[3];
+    mCPVGeometry.absToRelNumbering(digit.getAbsId(), relId);
+    //reminder: relId[3]={Module, phi col, z row} where Module=2..4, phi col=0..127, z row=0..59
+    mHist2D[H2DDigitMapM2 + relId[0] - 2]->Fill(relId[1], relId[2]);
+    addAmplitude(digit.getAbsId(), digit.getAmplitude());
+    mIsUpdatedAmplitude[digit.getAbsId()] = true;
+  }
+
+  //mNEventsTotal += triggerRecords.size();//number of events in the current input
+  for (const auto& trigRecord : triggerRecords) {
+    ILOG(Info, Devel) << " monitorData() : trigger record #" << mNEventsTotal
+                      << " contains " << trigRecord.getNumberOfObjects() << " objects." << ENDM;
+    if (trigRecord.getNumberOfObjects() > 0) { //at least 1 digit -> pedestal event
+      mNEventsTotal++;
+      mNEventsFromLastFillHistogramsCall++;
+    }
+  }
+}
+
 void PedestalTask::endOfCycle()
 {
   ILOG(Info, Support) << "endOfCycle. I call fillHistograms()" << ENDM;
@@ -190,8 +220,16 @@ void PedestalTask::reset()
 void PedestalTask::initHistograms()
 {
   //create monitoring histograms (or reset, if they already exist)
+  if (mCompactMode) {
+    mCompactSpectra.assign(kNChannels * kNCompactBins, 0);
+  }
   for (int i = 0; i < kNChannels; i++) {
-    if (!mHistAmplitudes[i]) {
+    if (mCompactMode) {
+      //only the spectra of the bad channels are created, when they are found
+      if (mHistAmplitudes[i]) {
+        mHistAmplitudes[i]->Reset();
+      }
+    } else if (!mHistAmplitudes[i]) {
       mHistAmplitudes[i] =
         new TH1F(Form("HistAmplitude%d", i), Form("HistAmplitude%d", i), 4096, 0., 4096.);
       //publish some of them
@@ -202,6 +240,7 @@ void PedestalTask::initHistograms()
       mHistAmplitudes[i]->Reset();
     }
     mIsUpdatedAmplitude[i] = false;
+    resetAmplitudeStatistics(i);
   }
 
   //1D Histos
@@ -370,15 +409,49 @@ void PedestalTask::initHistograms()
   }
 }
 
+PedestalTask::ChannelPedestal PedestalTask::computePedestal(int channel, TSpectrum& peakSearcher, TF1& functionGaus, TH1F& scratch)
+{
+  ChannelPedestal pedestal;
+  double mean = mAmplitudeSum[channel] / mNAmplitudes[channel];
+  double stdDev = std::sqrt(std::max(0., mAmplitudeSum2[channel] / mNAmplitudes[channel] - mean * mean));
+
+  // a narrow distribution of amplitudes can only have one peak, its mean and RMS are the pedestal value and sigma
+  if (mFastPathMaxSigma > 0 && mNAmplitudes[channel] > 1 && stdDev < mFastPathMaxSigma) {
+    pedestal.numberOfPeaks = 1;
+    pedestal.value = mean;
+    pedestal.sigma = stdDev;
+    return pedestal;
+  }
+
+  TH1F* amplitudes = mHistAmplitudes[channel];
+  if (mCompactMode) {
+    fillFromCompactSpectrum(channel, scratch);
+    amplitudes = &scratch;
+  }
+
+  pedestal.numberOfPeaks = peakSearcher.Search(amplitudes, 10., "nobackground nodraw", 0.2);
+  double* xPeaks = peakSearcher.GetPositionX();
+
+  if (pedestal.numberOfPeaks == 1) { // only 1 peak, fit spectrum with gaus
+    double yPeak = amplitudes->GetBinContent(amplitudes->GetXaxis()->FindBin(xPeaks[0]));
+    functionGaus.SetParameters(yPeak, xPeaks[0], 2.);
+    amplitudes->Fit(&functionGaus, "WWQ", "", xPeaks[0] - 20., xPeaks[0] + 20.);
+    pedestal.value = functionGaus.GetParameter(1);
+    pedestal.sigma = functionGaus.GetParameter(2);
+  } else if (pedestal.numberOfPeaks > 1) { // >1 peaks, no fit. Just use mean and stddev as ped value & sigma
+    pedestal.value = mean;
+    if (pedestal.value > 0)
+      pedestal.value = -pedestal.value; //let it be negative so we can know it's bad later
+    pedestal.sigma = stdDev;
+  }
+  return pedestal;
+}
+
 void PedestalTask::fillHistograms()
 {
   // count pedestals and update MOs
-  float pedestalValue, pedestalSigma, pedestalEfficiency;
+  float pedestalEfficiency;
   short relId[3];
-  TF1* functionGaus = new TF1("functionGaus", "gaus", 0., 4095.);
-  TSpectrum* peakSearcher = new TSpectrum(5); //find up to 5 pedestal peaks
-  int numberOfPeaks;                          //number of pedestal peaks in channel. Normaly it's 1, otherwise channel is bad
-  double *xPeaks, yPeaks[5];                  // arrays of x-position of the peaks and their heights
 
   //first, reset pedestal histograms
   for (int mod = 0; mod < 3; mod++) {
@@ -391,67 +464,92 @@ void PedestalTask::fillHistograms()
     mHist1D[H1DPedestalEfficiencyM2 + mod]->Reset();
   }
 
-  //then fill them with actual values
+  //then find the pedestals of the channels which have data, in parallel if possible
+  std::vector<ChannelPedestal> pedestals(kNChannels);
+  if (mFitPool) {
+    constexpr int chunkSize = 256;
+    std::atomic<int> nextChannel{ 0 };
+    std::vector<std::future<void>> results;
+    for (size_t worker = 0; worker < mFitPool->size(); worker++) {
+      results.emplace_back(mFitPool->submit([this, worker, &nextChannel, &pedestals]() {
+        TF1 functionGaus(("functionGaus" + std::to_string(worker)).c_str(), "gaus", 0., 4095.);
+        TSpectrum peakSearcher(5); //find up to 5 pedestal peaks
+        TH1F scratch(("scratchAmplitude" + std::to_string(worker)).c_str(), "", kNCompactBins, 0., kNCompactBins);
+        scratch.SetDirectory(nullptr);
+        for (int first = nextChannel.fetch_add(chunkSize); first < kNChannels; first = nextChannel.fetch_add(chunkSize)) {
+          for (int channel = first; channel < std::min(first + chunkSize, int(kNChannels)); channel++) {
+            if (mIsUpdatedAmplitude[channel]) {
+              pedestals[channel] = computePedestal(channel, peakSearcher, functionGaus, scratch);
+            }
+          }
+        }
+      }));
+    }
+    std::exception_ptr error;
+    for (auto& result : results) {
+      try {
+        result.get();
+      } catch (...) {
+        error = error ? error : std::current_exception();
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  } else {
+    TF1 functionGaus("functionGaus", "gaus", 0., 4095.);
+    TSpectrum peakSearcher(5); //find up to 5 pedestal peaks
+    TH1F scratch("scratchAmplitude", "", kNCompactBins, 0., kNCompactBins);
+    scratch.SetDirectory(nullptr);
+    for (int channel = 0; channel < kNChannels; channel++) {
+      if (mIsUpdatedAmplitude[channel]) {
+        pedestals[channel] = computePedestal(channel, peakSearcher, functionGaus, scratch);
+      }
+    }
+  }
+
+  //and fill the histograms with actual values
   for (int channel = 0; channel < kNChannels; channel++) {
-    if (!mHistAmplitudes[channel]) {
+    if (!mIsUpdatedAmplitude[channel])
+      continue; //no data in channel, skipping it
+
+    if (!mCompactMode && !mHistAmplitudes[channel]) {
       ILOG(Error, Devel) << "fillHistograms() : histo mHistAmplitudes[" << channel
                          << "] does not exist! Something is going wrong." << ENDM;
       continue;
     }
-    if (!mIsUpdatedAmplitude[channel])
-      continue; //no data in channel, skipping it
 
-    if (channel % 1000 == 0) {
-      ILOG(Info, Devel) << "fillHistograms(): Start to search peaks in channel " << channel << ENDM;
-      LOG(INFO) << "fillHistograms(): Start to search peaks in channel " << channel;
+    const auto& pedestal = pedestals[channel];
+    if (mCompactMode && (mHistAmplitudes[channel] || pedestal.numberOfPeaks != 1)) {
+      //the spectrum of a bad channel is created from the compact one, and kept up to date once it exists
+      if (!mHistAmplitudes[channel]) {
+        mHistAmplitudes[channel] =
+          new TH1F(Form("HistAmplitude%d", channel), Form("HistAmplitude%d", channel), kNCompactBins, 0., kNCompactBins);
+      }
+      fillFromCompactSpectrum(channel, *mHistAmplitudes[channel]);
     }
-
-    numberOfPeaks = peakSearcher->Search(mHistAmplitudes[channel], 10., "nobackground", 0.2);
-    xPeaks = peakSearcher->GetPositionX();
-
-    if (numberOfPeaks == 1) { // only 1 peak, fit spectrum with gaus
-      yPeaks[0] = mHistAmplitudes[channel]
-                    ->GetBinContent(mHistAmplitudes[channel]->GetXaxis()->FindBin(xPeaks[0]));
-      functionGaus->SetParameters(yPeaks[0], xPeaks[0], 2.);
-      mHistAmplitudes[channel]->Fit(functionGaus, "WWQ", "", xPeaks[0] - 20., xPeaks[0] + 20.);
-      pedestalValue = functionGaus->GetParameter(1);
-      pedestalSigma = functionGaus->GetParameter(2);
-      //stop publish this amplitude as it's OK (that fails due to some unclear reason)
-      //if (getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())){
-      //getObjectsManager()->stopPublishing(mHistAmplitudes[channel]->GetName());
-      //}
-    } else {
-      if (numberOfPeaks > 1) { // >1 peaks, no fit. Just use mean and stddev as ped value & sigma
-        pedestalValue = mHistAmplitudes[channel]->GetMean();
-        if (pedestalValue > 0)
-          pedestalValue = -pedestalValue; //let it be negative so we can know it's bad later
-        pedestalSigma = mHistAmplitudes[channel]->GetStdDev();
-        //let's publish this bad amplitude
-        if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
-          getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
-        }
-      } else { //numberOfPeaks < 1 - what is it?
-        //no peaks found((( OK let's show the spectrum to the world...
-        if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
-          getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
-        }
-        continue;
+    if (pedestal.numberOfPeaks != 1) {
+      //several peaks or no peaks found((( OK let's show the spectrum to the world...
+      if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
+        getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
       }
+      if (pedestal.numberOfPeaks < 1)
+        continue;
     }
 
-    pedestalEfficiency = mHistAmplitudes[channel]->GetEntries() / mNEventsTotal;
+    pedestalEfficiency = float(mNAmplitudes[channel]) / mNEventsTotal;
     mCPVGeometry.absToRelNumbering(channel, relId);
     mHist2D[H2DPedestalValueMapM2 + relId[0] - 2]
-      ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestalValue);
+      ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestal.value);
     mHist2D[H2DPedestalSigmaMapM2 + relId[0] - 2]
-      ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestalSigma);
+      ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestal.sigma);
     mHist2D[H2DPedestalEfficiencyMapM2 + relId[0] - 2]
       ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestalEfficiency);
     mHist2D[H2DPedestalNPeaksMapM2 + relId[0] - 2]
-      ->SetBinContent(relId[1] + 1, relId[2] + 1, numberOfPeaks);
+      ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestal.numberOfPeaks);
 
-    mHist1D[H1DPedestalValueM2 + relId[0] - 2]->Fill(pedestalValue);
-    mHist1D[H1DPedestalSigmaM2 + relId[0] - 2]->Fill(pedestalSigma);
+    mHist1D[H1DPedestalValueM2 + relId[0] - 2]->Fill(pedestal.value);
+    mHist1D[H1DPedestalSigmaM2 + relId[0] - 2]->Fill(pedestal.sigma);
     mHist1D[H1DPedestalEfficiencyM2 + relId[0] - 2]->Fill(pedestalEfficiency);
   }
 
@@ -465,8 +563,11 @@ void PedestalTask::resetHistograms()
   // clean all histograms
   ILOG(Info, Support) << "Resetting amplitude histograms" << ENDM;
   for (int i = 0; i < kNChannels; i++) {
-    mHistAmplitudes[i]->Reset();
+    if (mHistAmplitudes[i]) {
+      mHistAmplitudes[i]->Reset();
+    }
     mIsUpdatedAmplitude[i] = false;
+    resetAmplitudeStatistics(i);
   }
 
   ILOG(Info, Support) << "Resetting the 1D Histograms" << ENDM;
@@ -480,4 +581,49 @@ void PedestalTask::resetHistograms()
   }
 }
 
+void PedestalTask::addAmplitude(int channel, float amplitude)
+{
+  mNAmplitudes[channel]++;
+  mAmplitudeSum[channel] += amplitude;
+  mAmplitudeSum2[channel] += double(amplitude) * amplitude;
+
+  if (!mCompactMode) {
+    mHistAmplitudes[channel]->Fill(amplitude);
+    return;
+  }
+  if (amplitude < 0 || amplitude >= kNCompactBins) {
+    return; //far from any pedestal, it is only taken into account in the mean and RMS
+  }
+  auto* spectrum = &mCompactSpectra[channel * kNCompactBins];
+  auto& count = spectrum[int(amplitude)];
+  if (count == UINT16_MAX) {
+    //the bin would overflow, the whole spectrum is halved to keep its shape
+    for (int bin = 0; bin < kNCompactBins; bin++) {
+      spectrum[bin] /= 2;
+    }
+  }
+  count++;
+}
+
+void PedestalTask::resetAmplitudeStatistics(int channel)
+{
+  mNAmplitudes[channel] = 0;
+  mAmplitudeSum[channel] = 0.;
+  mAmplitudeSum2[channel] = 0.;
+  if (mCompactMode) {
+    std::fill_n(mCompactSpectra.begin() + channel * kNCompactBins, kNCompactBins, 0);
+  }
+}
+
+void PedestalTask::fillFromCompactSpectrum(int channel, TH1F& histogram) const
+{
+  histogram.Reset();
+  const auto* spectrum = &mCompactSpectra[channel * kNCompactBins];
+  for (int bin = 0; bin < kNCompactBins; bin++) {
+    histogram.SetBinContent(bin + 1, spectrum[bin]);
+  }
+  histogram.ResetStats();
+  histogram.SetEntries(mNAmplitudes[channel]);
+}
+
 } // namespace o2::quality_control_modules::cpv
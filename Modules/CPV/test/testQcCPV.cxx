@@ -14,6 +14,43 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "QualityControl/ObjectsManager.h"
+#include "CPV/PedestalTask.h"
+#include <CommonDataFormat/InteractionRecord.h>
+#include <Framework/ConfigParamRegistry.h>
+#include <Framework/InitContext.h>
+#include <Framework/ServiceRegistry.h>
+#include <TH2.h>
+#include <TRandom3.h>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#if (__has_include(<Framework/ConfigParamStore.h>))
+#include <Framework/ConfigParamStore.h>
+o2::framework::ConfigParamRegistry createDummyRegistry()
+{
+  using namespace o2::framework;
+  std::vector<ConfigParamSpec> specs;
+  std::vector<std::unique_ptr<ParamRetriever>> retrievers;
+
+  auto store = std::make_unique<ConfigParamStore>(specs, std::move(retrievers));
+  store->preload();
+  store->activate();
+  ConfigParamRegistry registry(std::move(store));
+
+  return registry;
+}
+#else
+o2::framework::ConfigParamRegistry createDummyRegistry()
+{
+  using namespace o2::framework;
+  std::unique_ptr<ParamRetriever> retriever;
+  ConfigParamRegistry registry(move(retriever));
+
+  return registry;
+}
+#endif
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -26,4 +63,63 @@ namespace o2::quality_control_modules::cpv
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+BOOST_AUTO_TEST_CASE(parallel_pedestals)
+{
+  // pedestal events with one gaussian peak per channel, the same for both tasks
+  constexpr int nChannels = 500;
+  constexpr int nEvents = 1000;
+  TRandom3 random(42);
+  std::vector<o2::cpv::Digit> digits;
+  std::vector<o2::cpv::TriggerRecord> triggerRecords;
+  for (int event = 0; event < nEvents; event++) {
+    triggerRecords.emplace_back(o2::InteractionRecord(event % 3564, event / 3564), digits.size(), nChannels);
+    for (int channel = 0; channel < nChannels; channel++) {
+      digits.emplace_back(channel, std::round(random.Gaus(50. + channel % 100, 2. + channel % 3)), -1);
+    }
+  }
+
+  // the pedestal maps found with the given number of threads, the task is deleted once they are copied
+  auto computePedestals = [&](bool compact, const std::string& fitThreads) {
+    auto objectsManager = std::make_shared<ObjectsManager>("PedestalTask" + fitThreads, "CPV", "", 0, true);
+    auto task = std::make_unique<PedestalTask>();
+    task->setObjectsManager(objectsManager);
+    task->setCustomParameters({ { "compactAmplitudes", compact ? "true" : "false" }, { "fitThreads", fitThreads } });
+    auto options = createDummyRegistry();
+    o2::framework::ServiceRegistry services;
+    o2::framework::InitContext ctx(options, services);
+    task->initialize(ctx);
+    task->processDigits(digits, triggerRecords);
+    Activity activity;
+    task->endOfActivity(activity); // the pedestals are computed at the end of the activity
+
+    std::map<std::string, std::vector<double>> maps;
+    for (const auto* name : { "PedestalValueMapM2", "PedestalSigmaMapM2", "PedestalNPeaksMapM2" }) {
+      auto* map = dynamic_cast<TH2F*>(objectsManager->getMonitorObject(name)->getObject());
+      BOOST_REQUIRE(map != nullptr);
+      BOOST_CHECK_GT(map->GetEntries(), 0);
+      for (int bin = 0; bin < map->GetNcells(); bin++) {
+        maps[name].push_back(map->GetBinContent(bin));
+      }
+    }
+    return maps;
+  };
+
+  // the spectra are kept either in compact arrays or in one histogram per channel
+  for (bool compact : { true, false }) {
+    BOOST_TEST_CONTEXT("compact amplitudes: " << compact)
+    {
+      auto sequential = computePedestals(compact, "1");
+      auto parallel = computePedestals(compact, "4");
+      for (const auto& [name, expected] : sequential) {
+        const auto& actual = parallel.at(name);
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (size_t bin = 0; bin < expected.size(); bin++) {
+          // the sequential fits might use another minimizer than Minuit2, the results agree much better than their errors
+          BOOST_CHECK_SMALL(actual[bin] - expected[bin], 0.01);
+        }
+      }
+    }
+  }
+}
+
 } // namespace o2::quality_control_modules::cpv
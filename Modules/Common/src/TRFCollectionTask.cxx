@@ -16,7 +16,6 @@
 #include "Common/TRFCollectionTask.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/DatabaseInterface.h"
-#include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/RepoPathUtils.h"
 
 #include <DataFormatsQualityControl/TimeRangeFlagCollection.h>
@@ -49,15 +48,10 @@ void TRFCollectionTask::initialize(Trigger t, framework::ServiceRegistry&)
 TimeRangeFlagCollection TRFCollectionTask::transformQualities(repository::DatabaseInterface& qcdb, const uint64_t timestampLimitStart, const uint64_t timestampLimitEnd)
 {
   // ------ HELPERS ------
-  std::function<std::vector<uint64_t>(const std::string& /*QO*/)> fetchAvailableTimestamps;
-  try {
-    fetchAvailableTimestamps = [&qcdbAsCcdb = dynamic_cast<repository::CcdbDatabase&>(qcdb), &detector = mConfig.detector](const std::string& qo) {
-      std::string path = RepoPathUtils::getQoPath(detector, qo);
-      return qcdbAsCcdb.getTimestampsForObject(path);
-    };
-  } catch (std::bad_cast& ex) {
-    ILOG(Error) << "Could not cast the database interface to CcdbDatabase, this task supports only the CCDB backend" << ENDM
-  }
+  auto fetchAvailableTimestamps = [&qcdb, &detector = mConfig.detector](const std::string& qo) {
+    std::string path = RepoPathUtils::getQoPath(detector, qo);
+    return qcdb.getTimestampsForObject(path);
+  };
 
   const char* noQualityObjectsComment = "No Quality Objects found within the specified time range";
 
@@ -80,16 +74,28 @@ TimeRangeFlagCollection TRFCollectionTask::transformQualities(repository::Databa
       continue;
     }
 
+    // all the QOs needed below are retrieved at once, so that the repository can fetch them concurrently
+    auto firstRetrievedTimestamp = firstMatchingTimestamp != availableTimestamps.begin() ? firstMatchingTimestamp - 1 : firstMatchingTimestamp;
+    auto endRetrievedTimestamp = std::lower_bound(firstMatchingTimestamp, availableTimestamps.end(), timestampLimitEnd);
+    std::vector<repository::DatabaseInterface::RetrievalRequest> requests;
+    for (auto timestamp = firstRetrievedTimestamp; timestamp != endRetrievedTimestamp; timestamp++) {
+      requests.push_back({ qoPath, static_cast<long>(*timestamp) });
+    }
+    auto retrievedQOs = qcdb.retrieveMany(requests);
+    auto getQO = [&](std::vector<uint64_t>::iterator timestamp) {
+      auto qo = repository::DatabaseInterface::toQualityObject(std::move(retrievedQOs[timestamp - firstRetrievedTimestamp]));
+      if (qo == nullptr) {
+        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(*timestamp) + "'");
+      }
+      return qo;
+    };
+
     std::optional<TimeRangeFlag> currentTRF;
     auto currentEndTime = *firstMatchingTimestamp;
     // if available, we move one timestamp back, because 'validUntil' might cover our period.
     if (firstMatchingTimestamp != availableTimestamps.begin()) {
 
-      auto currentObjTimestamp = firstMatchingTimestamp - 1;
-      auto qo = qcdb.retrieveQO(qoPath, *currentObjTimestamp);
-      if (qo == nullptr) {
-        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(*currentObjTimestamp) + "'");
-      }
+      auto qo = getQO(firstMatchingTimestamp - 1);
       uint64_t validUntil = strtoull(qo->getMetadata("Valid-Until").c_str(), nullptr, 10);
       currentEndTime = validUntil > timestampLimitEnd ? timestampLimitEnd : validUntil;
 
@@ -105,14 +111,9 @@ TimeRangeFlagCollection TRFCollectionTask::transformQualities(repository::Databa
     }
 
     // the main loop over QOs
-    for (auto currentStartTime = firstMatchingTimestamp;
-         currentStartTime != availableTimestamps.end() && *currentStartTime < timestampLimitEnd;
-         currentStartTime++) {
+    for (auto currentStartTime = firstMatchingTimestamp; currentStartTime != endRetrievedTimestamp; currentStartTime++) {
 
-      auto newQO = qcdb.retrieveQO(qoPath, *currentStartTime);
-      if (newQO == nullptr) {
-        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(*currentStartTime) + "'");
-      }
+      auto newQO = getQO(currentStartTime);
       totalQOsIncluded++;
       if (newQO->getQuality().isWorseThan(Quality::Good)) {
         totalWorseThanGoodQOs++;
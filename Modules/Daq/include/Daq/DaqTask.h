@@ -18,7 +18,10 @@
 
 #include "QualityControl/TaskInterface.h"
 #include <Headers/DAQID.h>
+#include <array>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 
 class TH1F;
@@ -29,8 +32,9 @@ namespace o2::quality_control_modules::daq
 {
 /// \brief Dataflow task
 /// It does only look at the header and plots sizes (e.g. payload).
-/// It also can print the headers and the payloads by setting printHeaders to "1"
-/// and printPayload to "hex" or "bin" in the config file under "taskParameters".
+/// It also can print the headers and the payloads by setting printInputHeader to "true"
+/// and printInputPayload to "hex" or "bin" in the config file under "taskParameters".
+/// Unless the pages or the RDHs are printed, the RDHs are read directly in the payloads, without DPLRawParser.
 /// \author Barthelemy von Haller
 class DaqTask final : public o2::quality_control::core::TaskInterface
 {
@@ -50,9 +54,34 @@ class DaqTask final : public o2::quality_control::core::TaskInterface
   void reset() override;
 
  private:
+  enum class PayloadRepresentation { None,
+                                     Hex,
+                                     Bin };
+
+  /// Number of RDHs per memory size, for one subsystem.
+  /// They are accumulated during the cycle and added to the histogram of the subsystem at its end.
+  struct RdhSizeCounts {
+    std::array<uint32_t, std::numeric_limits<uint16_t>::max() + 1> counts{};
+    uint64_t entries = 0;
+    double sum = 0;
+    double sum2 = 0;
+  };
+
   void printInputPayload(const header::DataHeader* header, const char* payload);
   void monitorInputRecord(o2::framework::InputRecord& inputRecord);
   void monitorRDHs(o2::framework::InputRecord& inputRecord);
+  void monitorRDHsWithParser(o2::framework::InputRecord& inputRecord);
+  void countRDH(o2::header::DAQID::ID source, uint16_t memorySize);
+  void fillRDHPlots(o2::header::DAQID::ID source, size_t numberOfRDHs, size_t totalSize);
+  void flushRDHSizes();
+
+  // ** configuration, parsed once from the custom parameters
+
+  bool mPrintInputHeader = false;
+  PayloadRepresentation mPrintInputPayload = PayloadRepresentation::None;
+  size_t mPrintInputPayloadLimit = std::numeric_limits<size_t>::max();
+  bool mPrintPageInfo = false;
+  bool mPrintRDH = false;
 
   // ** general information
 
@@ -73,7 +102,10 @@ class DaqTask final : public o2::quality_control::core::TaskInterface
 
   // Per detector information
   std::map<o2::header::DAQID::ID, TH1F*> mSubSystemsTotalSizes; // filled with the sum of RDH memory sizes per InputRecord
-  std::map<o2::header::DAQID::ID, TH1F*> mSubSystemsRdhSizes;   // filled with the RDH memory sizes for each RDH
+  std::map<o2::header::DAQID::ID, TH1F*> mSubSystemsRdhSizes;   // filled with the RDH memory sizes for each RDH, at the end of cycle
+  std::array<bool, std::numeric_limits<o2::header::DAQID::ID>::max() + 1> mValidSystems{};                         // true for the IDs in mSystems
+  std::array<std::unique_ptr<RdhSizeCounts>, std::numeric_limits<o2::header::DAQID::ID>::max() + 1> mRdhSizeCounts; // created for the subsystems we see
+  size_t mNumberOfInvalidPages = 0;
   // todo : for the next one we need to know the number of links per detector.
   //  std::map<o2::header::DAQID::ID, TH1F*> mSubSystemsRdhHits; // hits per link split by detector
   // todo we could add back the graph for the IDs using the TFID
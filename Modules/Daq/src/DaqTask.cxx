@@ -48,16 +48,32 @@ DaqTask::~DaqTask()
   delete mNumberRDHs;
 }
 
-// TODO remove this function once the equivalent is available in O2 DAQID
-bool isDetIdValid(DAQID::ID id)
-{
-  return (id < DAQID::MAXDAQ + 1) && (DAQID::DAQtoO2(id) != gDataOriginInvalid);
-}
-
 void DaqTask::initialize(o2::framework::InitContext& /*ctx*/)
 {
   ILOG(Info, Support) << "Initializiation of DaqTask" << ENDM;
 
+  // the parameters are parsed only once, they would be looked up for each input and page otherwise
+  if (auto param = mCustomParameters.find("printInputHeader"); param != mCustomParameters.end()) {
+    mPrintInputHeader = param->second == "true";
+  }
+  if (auto param = mCustomParameters.find("printInputPayload"); param != mCustomParameters.end()) {
+    if (param->second == "hex") {
+      mPrintInputPayload = PayloadRepresentation::Hex;
+    } else if (param->second == "bin") {
+      mPrintInputPayload = PayloadRepresentation::Bin;
+    }
+  }
+  if (auto param = mCustomParameters.find("printInputPayloadLimit"); param != mCustomParameters.end()) {
+    auto limit = std::stoll(param->second);
+    mPrintInputPayloadLimit = limit < 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(limit);
+  }
+  if (auto param = mCustomParameters.find("printPageInfo"); param != mCustomParameters.end()) {
+    mPrintPageInfo = param->second == "true";
+  }
+  if (auto param = mCustomParameters.find("printRDH"); param != mCustomParameters.end()) {
+    mPrintRDH = param->second == "true";
+  }
+
   // General plots, related mostly to the payload size (InputRecord, Inputs) and the numbers of RDHs and Inputs in an InputRecord.
   mInputRecordPayloadSize = new TH1F("inputRecordSize", "Total payload size per InputRecord;bytes", 128, 0, 2047);
   mInputRecordPayloadSize->SetCanExtend(TH1::kXaxis);
@@ -76,9 +92,11 @@ void DaqTask::initialize(o2::framework::InitContext& /*ctx*/)
     DataOrigin origin = DAQID::DAQtoO2(i);
     if (origin != gDataOriginInvalid) {
       mSystems[i] = origin.str;
+      mValidSystems[i] = true;
     }
   }
   mSystems[DAQID::INVALID] = "UNKNOWN"; // to store RDH info for unknown detectors
+  mValidSystems[DAQID::INVALID] = true;
 
   // subsystems plots: distribution of rdh size, distribution of the sum of rdh in each message.
   for (const auto& system : mSystems) {
@@ -108,13 +126,23 @@ void DaqTask::startOfCycle()
 void DaqTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
   monitorInputRecord(ctx.inputs());
-  monitorRDHs(ctx.inputs());
+  if (mPrintPageInfo || mPrintRDH) {
+    monitorRDHsWithParser(ctx.inputs());
+  } else {
+    monitorRDHs(ctx.inputs());
+  }
 }
 
 void DaqTask::endOfCycle()
 {
   ILOG(Info, Support) << "endOfCycle" << ENDM;
 
+  flushRDHSizes();
+  if (mNumberOfInvalidPages > 0) {
+    ILOG(Warning, Support) << "Could not walk through " << mNumberOfInvalidPages << " pages during this cycle" << ENDM;
+    mNumberOfInvalidPages = 0;
+  }
+
   // TODO make this optional once we are able to know the run number and the detectors included.
   //      It might still be necessary in test runs without a proper run number.
   for (auto toBeAdded : mToBePublished) {
@@ -157,20 +185,21 @@ void DaqTask::reset()
     mSubSystemsRdhSizes.at(system.first)->Reset();
     mSubSystemsTotalSizes.at(system.first)->Reset();
   }
+  for (auto& counts : mRdhSizeCounts) {
+    counts.reset();
+  }
+  mNumberOfInvalidPages = 0;
 }
 
 void DaqTask::printInputPayload(const header::DataHeader* header, const char* payload)
 {
   std::vector<std::string> representation;
-  if (mCustomParameters["printInputPayload"] == "hex") {
+  if (mPrintInputPayload == PayloadRepresentation::Hex) {
     representation = getHexRepresentation((unsigned char*)payload, header->payloadSize);
-  } else if (mCustomParameters["printInputPayload"] == "bin") {
+  } else if (mPrintInputPayload == PayloadRepresentation::Bin) {
     representation = getBinRepresentation((unsigned char*)payload, header->payloadSize);
   }
-  size_t limit = std::numeric_limits<size_t>::max();
-  if (mCustomParameters.count("printInputPayloadLimit") > 0) {
-    limit = std::stoi(mCustomParameters["printInputPayloadLimit"]);
-  }
+  const size_t limit = mPrintInputPayloadLimit;
 
   for (size_t i = 0; i < representation.size();) {
     ILOG(Info, Ops) << std::setw(4) << i << " : ";
@@ -207,10 +236,10 @@ void DaqTask::monitorInputRecord(InputRecord& inputRecord)
       totalPayloadSize += size;
 
       // printing
-      if (mCustomParameters.count("printInputHeader") > 0 && mCustomParameters["printInputHeader"] == "true") {
+      if (mPrintInputHeader) {
         std::cout << fmt::format("{}", *header) << std::endl;
       }
-      if (mCustomParameters.count("printInputPayload") > 0) {
+      if (mPrintInputPayload != PayloadRepresentation::None) {
         printInputPayload(header, payload);
       }
     } else {
@@ -236,6 +265,46 @@ void printPage(const DPLRawParser::Iterator<const DataRef>& data)
 }
 
 void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
+{
+  // Walks through the pages of each input with the offsets to the next RDH, reading only the headers.
+  size_t rdhCounter = 0;
+  size_t totalSize = 0;
+  DAQID::ID rdhSource = DAQID::INVALID;
+  for (const auto& input : InputRecordWalker(inputRecord)) {
+    if (input.header == nullptr || input.payload == nullptr) {
+      continue;
+    }
+    const auto* header = o2::header::get<header::DataHeader*>(input.header);
+    const char* payload = input.payload;
+    const size_t payloadSize = header->payloadSize;
+
+    size_t position = 0;
+    while (position + sizeof(o2::header::RDHAny) <= payloadSize) {
+      const auto* rdh = reinterpret_cast<const o2::header::RDHAny*>(payload + position);
+      size_t offsetToNext = 0;
+      try {
+        rdhSource = RDHUtils::getVersion(rdh) >= 6 ? RDHUtils::getSourceID(rdh) : DAQID::INVALID; // there is no sourceID before v6
+        const auto memorySize = RDHUtils::getMemorySize(rdh);
+        offsetToNext = RDHUtils::getOffsetToNext(rdh);
+        totalSize += memorySize;
+        rdhCounter++;
+        countRDH(rdhSource, memorySize);
+      } catch (std::runtime_error& e) {
+        // not a supported RDH, we cannot find the next one
+        offsetToNext = 0;
+      }
+      if (offsetToNext == 0 || position + offsetToNext > payloadSize) {
+        mNumberOfInvalidPages++;
+        break;
+      }
+      position += offsetToNext;
+    }
+  }
+
+  fillRDHPlots(rdhSource, rdhCounter, totalSize);
+}
+
+void DaqTask::monitorRDHsWithParser(o2::framework::InputRecord& inputRecord)
 {
   // Use the DPLRawParser to get information about the Pages and RDHs stored in the inputRecord
   o2::framework::DPLRawParser parser(inputRecord);
@@ -250,7 +319,7 @@ void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
     //    it.o2DataHeader()->print();
 
     // print page
-    if (mCustomParameters.count("printPageInfo") > 0 && mCustomParameters["printPageInfo"] == "true") {
+    if (mPrintPageInfo) {
       printPage(it);
     }
 
@@ -262,7 +331,7 @@ void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
     }
 
     // print RDH
-    if (mCustomParameters.count("printRDH") > 0 && mCustomParameters["printRDH"] == "true") {
+    if (mPrintRDH) {
       ILOG(Info, Ops) << "RDH: " << ENDM;
       RDHUtils::printRDH(rdh);
     }
@@ -270,26 +339,73 @@ void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
     // RDH plots
     try {
       rdhSource = RDHUtils::getVersion(rdh) >= 6 ? RDHUtils::getSourceID(rdh) : DAQID::INVALID; // there is no sourceID before v6
-      if (!isDetIdValid(rdhSource)) {                                                           // if we found it , is it valid ?
-        rdhSource = DAQID::INVALID;
-      }
       totalSize += RDHUtils::getMemorySize(rdh);
       rdhCounter++;
-      mSubSystemsRdhSizes.at(rdhSource)->Fill(RDHUtils::getMemorySize(rdh));
+      countRDH(rdhSource, RDHUtils::getMemorySize(rdh));
     } catch (std::runtime_error& e) {
       ILOG(Error, Devel) << "Catched an exception when accessing the rdh fields: \n"
                          << e.what() << ENDM;
     }
   }
 
-  mSubSystemsTotalSizes.at(rdhSource)->Fill(totalSize);
+  fillRDHPlots(rdhSource, rdhCounter, totalSize);
+}
+
+void DaqTask::countRDH(DAQID::ID source, uint16_t memorySize)
+{
+  auto& counts = mRdhSizeCounts[mValidSystems[source] ? source : DAQID::INVALID];
+  if (!counts) {
+    counts = std::make_unique<RdhSizeCounts>();
+  }
+  counts->counts[memorySize]++;
+  counts->entries++;
+  counts->sum += memorySize;
+  counts->sum2 += static_cast<double>(memorySize) * memorySize;
+}
+
+void DaqTask::fillRDHPlots(DAQID::ID source, size_t numberOfRDHs, size_t totalSize)
+{
+  if (!mValidSystems[source]) {
+    source = DAQID::INVALID;
+  }
+  mSubSystemsTotalSizes.at(source)->Fill(totalSize);
 
   // TODO make this optional once we are able to know the run number and the detectors included.
-  mToBePublished.insert(rdhSource);
+  mToBePublished.insert(source);
 
   // TODO why is the payload size reported by the dataref.header->print() different than the one from the sum
   //      of the RDH memory size + dataref header size ? a few hundreds bytes difference.
-  mNumberRDHs->Fill(rdhCounter);
+  mNumberRDHs->Fill(numberOfRDHs);
+}
+
+void DaqTask::flushRDHSizes()
+{
+  for (size_t id = 0; id < mRdhSizeCounts.size(); id++) {
+    auto& counts = mRdhSizeCounts[id];
+    if (!counts || counts->entries == 0) {
+      continue;
+    }
+    // Equivalent to filling each RDH size with a unit weight, including the statistics.
+    TH1F* histo = mSubSystemsRdhSizes.at(static_cast<DAQID::ID>(id));
+    double stats[4];
+    histo->GetStats(stats);
+    for (size_t size = 0; size < counts->counts.size(); size++) {
+      if (counts->counts[size] > 0) {
+        histo->AddBinContent(histo->FindBin(size), counts->counts[size]);
+      }
+    }
+    stats[0] += counts->entries;
+    stats[1] += counts->entries;
+    stats[2] += counts->sum;
+    stats[3] += counts->sum2;
+    histo->PutStats(stats);
+    histo->SetEntries(histo->GetEntries() + counts->entries);
+
+    counts->counts.fill(0);
+    counts->entries = 0;
+    counts->sum = 0;
+    counts->sum2 = 0;
+  }
 }
 
 } // namespace o2::quality_control_modules::daq
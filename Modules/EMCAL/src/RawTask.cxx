@@ -18,7 +18,9 @@
 #include <TH1.h>
 #include <TProfile2D.h>
 #include <TMath.h>
+#include <algorithm>
 #include <cfloat>
+#include <climits>
 
 #include "QualityControl/QcInfoLogger.h"
 #include "DetectorsRaw/RDHUtils.h"
@@ -63,42 +65,41 @@ RawTask::~RawTask()
   }
 
   for (auto& histos : mRawAmplitudeEMCAL) {
-    for (auto h : histos.second) {
-
+    for (auto h : histos) {
       delete h;
     }
   }
 
   for (auto& histos : mRawAmplMaxEMCAL) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
 
   for (auto& histos : mRawAmplMinEMCAL) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
   for (auto& histos : mRMSperSM) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
 
   for (auto& histos : mMEANperSM) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
 
   for (auto& histos : mMAXperSM) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
   for (auto& histos : mMINperSM) {
-    for (auto h : histos.second) {
+    for (auto h : histos) {
       delete h;
     }
   }
@@ -176,61 +177,53 @@ void RawTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   //histos per SM
 
-  std::array<std::string, 2> triggers = { { "CAL", "PHYS" } };
-  for (const auto& trg : triggers) {
-    std::array<TH1*, 20> histosRawAmplEMCALSM;
-    std::array<TH1*, 20> histosRawAmplMaxEMCALSM;
-    std::array<TH1*, 20> histosRawAmplMinEMCALSM;
-    std::array<TProfile2D*, 20> histosRawAmplRmsSM;
-    std::array<TProfile2D*, 20> histosRawAmplMeanSM;
-    std::array<TProfile2D*, 20> histosRawAmplMaxSM;
-    std::array<TProfile2D*, 20> histosRawAmplMinSM;
+  for (int trg = 0; trg < kNTriggerClasses; trg++) {
+    auto& histosRawAmplEMCALSM = mRawAmplitudeEMCAL[trg];
+    auto& histosRawAmplMaxEMCALSM = mRawAmplMaxEMCAL[trg];
+    auto& histosRawAmplMinEMCALSM = mRawAmplMinEMCAL[trg];
+    auto& histosRawAmplRmsSM = mRMSperSM[trg];
+    auto& histosRawAmplMeanSM = mMEANperSM[trg];
+    auto& histosRawAmplMaxSM = mMAXperSM[trg];
+    auto& histosRawAmplMinSM = mMINperSM[trg];
+    const char* trgName = kTriggerClassNames[trg];
 
-    for (auto ism = 0; ism < 20; ism++) {
+    for (auto ism = 0; ism < kNSupermodules; ism++) {
 
-      histosRawAmplEMCALSM[ism] = new TH1F(Form("RawAmplitudeEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplitudeEMCAL%d, %s", ism, trg.data()), 100, 0., 100.);
+      histosRawAmplEMCALSM[ism] = new TH1F(Form("RawAmplitudeEMCAL_sm%d_%s", ism, trgName), Form(" RawAmplitudeEMCAL%d, %s", ism, trgName), 100, 0., 100.);
       histosRawAmplEMCALSM[ism]->GetXaxis()->SetTitle("Raw Amplitude");
       histosRawAmplEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
       getObjectsManager()->startPublishing(histosRawAmplEMCALSM[ism]);
 
-      histosRawAmplMaxEMCALSM[ism] = new TH1F(Form("RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), 500, 0., 500.);
+      histosRawAmplMaxEMCALSM[ism] = new TH1F(Form("RawAmplMaxEMCAL_sm%d_%s", ism, trgName), Form(" RawAmplMaxEMCAL_sm%d_%s", ism, trgName), 500, 0., 500.);
       histosRawAmplMaxEMCALSM[ism]->GetXaxis()->SetTitle("Max Raw Amplitude [ADC]");
       histosRawAmplMaxEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
       getObjectsManager()->startPublishing(histosRawAmplMaxEMCALSM[ism]);
 
-      histosRawAmplMinEMCALSM[ism] = new TH1F(Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), 100, 0., 100.);
+      histosRawAmplMinEMCALSM[ism] = new TH1F(Form("RawAmplMinEMCAL_sm%d_%s", ism, trgName), Form("RawAmplMinEMCAL_sm%d_%s", ism, trgName), 100, 0., 100.);
       histosRawAmplMinEMCALSM[ism]->GetXaxis()->SetTitle("Min Raw Amplitude");
       histosRawAmplMinEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
       getObjectsManager()->startPublishing(histosRawAmplMinEMCALSM[ism]);
 
-      histosRawAmplRmsSM[ism] = new TProfile2D(Form("RMSADCperSM%d_%s", ism, trg.data()), Form("RMSperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
+      histosRawAmplRmsSM[ism] = new TProfile2D(Form("RMSADCperSM%d_%s", ism, trgName), Form("RMSperSM%d_%s", ism, trgName), 48, 0, 48, 24, 0, 24);
       histosRawAmplRmsSM[ism]->GetXaxis()->SetTitle("col");
       histosRawAmplRmsSM[ism]->GetYaxis()->SetTitle("row");
       getObjectsManager()->startPublishing(histosRawAmplRmsSM[ism]);
 
-      histosRawAmplMeanSM[ism] = new TProfile2D(Form("MeanADCperSM%d_%s", ism, trg.data()), Form("MeanADCperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
+      histosRawAmplMeanSM[ism] = new TProfile2D(Form("MeanADCperSM%d_%s", ism, trgName), Form("MeanADCperSM%d_%s", ism, trgName), 48, 0, 48, 24, 0, 24);
       histosRawAmplMeanSM[ism]->GetXaxis()->SetTitle("col");
       histosRawAmplMeanSM[ism]->GetYaxis()->SetTitle("row");
       getObjectsManager()->startPublishing(histosRawAmplMeanSM[ism]);
 
-      histosRawAmplMaxSM[ism] = new TProfile2D(Form("MaxADCperSM%d_%s", ism, trg.data()), Form("MaxADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
+      histosRawAmplMaxSM[ism] = new TProfile2D(Form("MaxADCperSM%d_%s", ism, trgName), Form("MaxADCperSM%d_%s", ism, trgName), 48, 0, 47, 24, 0, 23);
       histosRawAmplMaxSM[ism]->GetXaxis()->SetTitle("col");
       histosRawAmplMaxSM[ism]->GetYaxis()->SetTitle("row");
       getObjectsManager()->startPublishing(histosRawAmplMaxSM[ism]);
 
-      histosRawAmplMinSM[ism] = new TProfile2D(Form("MinADCperSM%d_%s", ism, trg.data()), Form("MinADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
+      histosRawAmplMinSM[ism] = new TProfile2D(Form("MinADCperSM%d_%s", ism, trgName), Form("MinADCperSM%d_%s", ism, trgName), 48, 0, 47, 24, 0, 23);
       histosRawAmplMinSM[ism]->GetXaxis()->SetTitle("col");
       histosRawAmplMinSM[ism]->GetYaxis()->SetTitle("raw");
       getObjectsManager()->startPublishing(histosRawAmplMinSM[ism]);
     } //loop SM
-    mRawAmplitudeEMCAL[trg] = histosRawAmplEMCALSM;
-    mRawAmplMaxEMCAL[trg] = histosRawAmplMaxEMCALSM;
-    mRawAmplMinEMCAL[trg] = histosRawAmplMinEMCALSM;
-    mRMSperSM[trg] = histosRawAmplRmsSM;
-    mMEANperSM[trg] = histosRawAmplMeanSM;
-    mMAXperSM[trg] = histosRawAmplMaxSM;
-    mMINperSM[trg] = histosRawAmplMinSM;
-
   } //loop trigger case
 }
 
@@ -291,8 +284,10 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
       o2::emcal::RawReaderMemory rawreader(gsl::span(input.payload, header->payloadSize));
       uint64_t currentTrigger(0);
       bool first = true; //for the first event
-      short int maxADCSM[20];
-      short int minADCSM[20];
+      std::array<short int, kNSupermodules> maxADCSM;
+      std::array<short int, kNSupermodules> minADCSM;
+      maxADCSM.fill(0);
+      minADCSM.fill(SHRT_MAX);
       while (rawreader.hasNext()) {
         QcInfoLogger::GetInstance() << QcInfoLogger::Debug << " Processing page " << mNumberOfPages << AliceO2::InfoLogger::InfoLogger::endm;
         mNumberOfPages++;
@@ -309,11 +304,11 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
         //trigger type
         auto triggertype = o2::raw::RDHUtils::getTriggerType(headerR);
         bool isPhysTrigger = triggertype & o2::trigger::PhT, isCalibTrigger = triggertype & o2::trigger::Cal;
-        std::string trgClass;
+        TriggerClass trgClass;
         if (isPhysTrigger)
-          trgClass = "PHYS";
+          trgClass = kPHYS;
         else if (isCalibTrigger)
-          trgClass = "CAL";
+          trgClass = kCAL;
         else {
           QcInfoLogger::GetInstance() << QcInfoLogger::Error << " Unmonitored trigger class requested " << AliceO2::InfoLogger::InfoLogger::endm;
           continue;
@@ -322,7 +317,7 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
         //fill histograms with max ADC for each supermodules and reset cache
         if (!first) {                       // check if it is the first event in the payload
           if (triggerBC > currentTrigger) { // new event
-            for (int sm = 0; sm < 20; sm++) {
+            for (int sm = 0; sm < kNSupermodules; sm++) {
 
               mRawAmplitudeEMCAL[trgClass][sm]->Fill(maxADCSM[sm]);
 
@@ -336,7 +331,7 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
           currentTrigger = triggerBC;
           first = false;
         }
-        if (feeID > 40)
+        if (feeID >= 2 * kNSupermodules)
           continue; //skip STU ddl
 
         o2::emcal::AltroDecoder decoder(rawreader); //(atrodecoder in Detectors/Emcal/reconstruction/src)
@@ -391,6 +386,13 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
         }
         int j = feeID / 2; //SM id
         auto& mapping = mMappings->getMappingForDDL(feeID);
+        //the histograms of the SM, resolved once for all the channels of the page
+        auto rawAmplMax = mRawAmplMaxEMCAL[trgClass][j];
+        auto rawAmplMin = mRawAmplMinEMCAL[trgClass][j];
+        auto rmsPerSM = mRMSperSM[trgClass][j];
+        auto meanPerSM = mMEANperSM[trgClass][j];
+        auto maxPerSM = mMAXperSM[trgClass][j];
+        auto minPerSM = mMINperSM[trgClass][j];
         int col;
 
         int row;
@@ -408,30 +410,31 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
           Double_t meanADC = 0;
           Double_t rmsADC = 0;
           for (auto& bunch : chan.getBunches()) {
-            auto adcs = bunch.getADC();
+            const auto& adcs = bunch.getADC();
 
-            auto maxADCbunch = *max_element(adcs.begin(), adcs.end());
+            auto [minElement, maxElement] = std::minmax_element(adcs.begin(), adcs.end());
+            auto maxADCbunch = *maxElement;
             if (maxADCbunch > maxADC)
               maxADC = maxADCbunch;
-            mRawAmplMaxEMCAL[trgClass][j]->Fill(maxADCbunch); //max for each cell
+            rawAmplMax->Fill(maxADCbunch); //max for each cell
 
-            auto minADCbunch = *min_element(adcs.begin(), adcs.end());
+            auto minADCbunch = *minElement;
             if (minADCbunch < minADC)
               minADC = minADCbunch;
-            mRawAmplMinEMCAL[trgClass][j]->Fill(minADCbunch); // min for each cell
+            rawAmplMin->Fill(minADCbunch); // min for each cell
 
             meanADC = TMath::Mean(adcs.begin(), adcs.end());
             rmsADC = TMath::RMS(adcs.begin(), adcs.end());
-            mRMSperSM[trgClass][j]->Fill(col, row, rmsADC);
-            mMEANperSM[trgClass][j]->Fill(col, row, meanADC);
+            rmsPerSM->Fill(col, row, rmsADC);
+            meanPerSM->Fill(col, row, meanADC);
           }
           if (maxADC > maxADCSM[j])
             maxADCSM[j] = maxADC;
-          mMAXperSM[trgClass][j]->Fill(col, row, maxADC);
+          maxPerSM->Fill(col, row, maxADC);
 
           if (minADC < minADCSM[j])
             minADCSM[j] = minADC;
-          mMINperSM[trgClass][j]->Fill(col, row, minADC);
+          minPerSM->Fill(col, row, minADC);
         } //channels
       }   //new page
     }     //header
@@ -458,9 +461,8 @@ void RawTask::reset()
 
   QcInfoLogger::GetInstance() << "Resetting the histogram" << AliceO2::InfoLogger::InfoLogger::endm;
   mHistogram->Reset();
-  std::array<std::string, 2> triggers = { { "CAL", "PHYS" } };
-  for (const auto& trg : triggers) {
-    for (Int_t i = 0; i < 20; i++) {
+  for (int trg = 0; trg < kNTriggerClasses; trg++) {
+    for (Int_t i = 0; i < kNSupermodules; i++) {
       mRawAmplitudeEMCAL[trg][i]->Reset();
       mRawAmplMaxEMCAL[trg][i]->Reset();
       mRawAmplMinEMCAL[trg][i]->Reset();
@@ -0,0 +1,102 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HmpidSuperpageDecoder.h
+/// \author Piotr Konopka
+///
+
+#ifndef QC_MODULE_HMPID_HMPIDSUPERPAGEDECODER_H
+#define QC_MODULE_HMPID_HMPIDSUPERPAGEDECODER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gsl/span>
+
+#include "HMPIDBase/Geo.h"
+
+namespace o2::quality_control_modules::hmpid
+{
+
+/// \brief Decoder of the pad samples of HMPID superpages, for the pedestal monitoring.
+///
+/// It reads the pages of the superpage in place, without copying them nor calling any virtual method. Like the fast
+/// decoding of o2::hmpid::HmpidDecoder2, it does not follow the row, segment and end of event markers: all the words
+/// which look like a valid pad word (bit 27 not set, column 1-24, dilogic 1-10, channel 0-47) and which are not
+/// a repetition of the previous word are taken as pad samples. The words of a page are classified in chunks by a
+/// branch-free loop, then the samples are added to the statistics of their channels.
+///
+/// The number of samples, the sum and the sum of squares of the charges of all the channels of all the equipments are
+/// kept in contiguous arrays, indexed by getChannelIndex(). They are accumulated until reset() is called.
+class HmpidSuperpageDecoder
+{
+ public:
+  static constexpr int kNEquipments = o2::hmpid::Geo::MAXEQUIPMENTS;
+  static constexpr int kNChannelsPerEquipment = o2::hmpid::Geo::N_COLUMNS * o2::hmpid::Geo::N_DILOGICS * o2::hmpid::Geo::N_CHANNELS;
+  static constexpr int kNChannels = kNEquipments * kNChannelsPerEquipment;
+
+  /// Uses the mapping of the equipments to CRUs and links at P2
+  HmpidSuperpageDecoder();
+  ~HmpidSuperpageDecoder() = default;
+
+  /// \brief Decodes the pages of the superpage and adds their samples to the statistics.
+  /// \return false if a page could not be decoded. The rest of the superpage is skipped if its size is not valid.
+  bool decode(gsl::span<const char> superpage);
+  /// Clears the statistics of all the channels and equipments
+  void reset();
+
+  /// \param column, dilogic, channel start from 0
+  static constexpr int getChannelIndex(int equipment, int column, int dilogic, int channel)
+  {
+    return ((equipment * o2::hmpid::Geo::N_COLUMNS + column) * o2::hmpid::Geo::N_DILOGICS + dilogic) * o2::hmpid::Geo::N_CHANNELS + channel;
+  }
+
+  uint32_t getChannelSamples(int equipment, int column, int dilogic, int channel) const { return getChannelSamples(getChannelIndex(equipment, column, dilogic, channel)); }
+  double getChannelSum(int equipment, int column, int dilogic, int channel) const { return getChannelSum(getChannelIndex(equipment, column, dilogic, channel)); }
+  double getChannelSquare(int equipment, int column, int dilogic, int channel) const { return getChannelSquare(getChannelIndex(equipment, column, dilogic, channel)); }
+  /// Access by the index of getChannelIndex(), to iterate over all the channels
+  uint32_t getChannelSamples(int index) const { return mSamples[index]; }
+  double getChannelSum(int index) const { return mSum[index]; }
+  double getChannelSquare(int index) const { return mSquares[index]; }
+
+  /// \return Average size of the events of the equipment in bytes, 0 if none was seen
+  float getAverageEventSize(int equipment) const;
+  /// \return Average busy time of the equipment in seconds, 0 if no event was seen
+  float getAverageBusyTime(int equipment) const;
+  /// \return Number of pages which could not be decoded since the last reset
+  size_t getNumberOfErrors() const { return mNumberOfErrors; }
+
+ private:
+  struct EquipmentStatistics {
+    uint32_t orbit = 0;
+    uint32_t numberOfEvents = 0;
+    double eventSizeSum = 0;
+    double busyTimeSum = 0;
+  };
+
+  void decodePayload(const uint32_t* words, size_t numberOfWords, int equipment);
+
+  static constexpr int kNCrus = 4;
+  static constexpr int kNLinks = 4;
+  std::array<std::array<int, kNLinks>, kNCrus> mEquipmentIds; ///< equipment ID for each CRU and link, -1 if none
+
+  std::vector<uint32_t> mSamples; ///< number of samples per channel
+  std::vector<uint64_t> mSum;     ///< sum of the charges per channel
+  std::vector<uint64_t> mSquares; ///< sum of the squared charges per channel
+  std::array<EquipmentStatistics, kNEquipments> mEquipments;
+  size_t mNumberOfErrors = 0;
+};
+
+} // namespace o2::quality_control_modules::hmpid
+
+#endif // QC_MODULE_HMPID_HMPIDSUPERPAGEDECODER_H
@@ -17,7 +17,9 @@
 #define QC_MODULE_HMPID_HMPIDHMPIDTASK_H
 
 #include "QualityControl/TaskInterface.h"
-#include "HMPIDReconstruction/HmpidDecoder2.h"
+#include "HMPID/HmpidSuperpageDecoder.h"
+
+#include <memory>
 
 class TH1F;
 
@@ -50,7 +52,7 @@ class HmpidTask final : public TaskInterface
   TH1F* hPedestalSigma = nullptr;
   TH1F* hBusyTime = nullptr;
   TH1F* hEventSize = nullptr;
-  o2::hmpid::HmpidDecoder2* mDecoder = nullptr;
+  std::unique_ptr<HmpidSuperpageDecoder> mDecoder;
 };
 
 } // namespace o2::quality_control_modules::hmpid
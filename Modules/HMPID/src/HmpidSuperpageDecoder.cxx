@@ -0,0 +1,154 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HmpidSuperpageDecoder.cxx
+/// \author Piotr Konopka
+///
+
+#include "HMPID/HmpidSuperpageDecoder.h"
+
+#include <algorithm>
+
+namespace o2::quality_control_modules::hmpid
+{
+
+namespace
+{
+
+// RDH v6, as read by o2::hmpid::HmpidDecoder2::decodeHeader
+constexpr size_t kMinimumHeaderSize = 64;
+constexpr double kBusyTimeUnit = 0.00000005; // s
+constexpr uint32_t kColumns = o2::hmpid::Geo::N_COLUMNS;
+constexpr uint32_t kDilogics = o2::hmpid::Geo::N_DILOGICS;
+constexpr uint32_t kChannelsPerDilogic = o2::hmpid::Geo::N_CHANNELS;
+
+/// Returns the index of the channel within its equipment if the word is a valid pad word, -1 otherwise.
+/// PAD : 0000.0ccc.ccdd.ddnn.nnnn.vvvv.vvvv.vvvv :: c=col,d=dilo,n=chan,v=value
+inline int32_t classify(uint32_t word, uint32_t previous)
+{
+  const uint32_t column = (word >> 22) & 0x1F;
+  const uint32_t dilogic = (word >> 18) & 0xF;
+  const uint32_t channel = (word >> 12) & 0x3F;
+  // the unsigned differences reject 0 as well
+  const bool isPad = (word & 0x08000000) == 0 && column - 1 < kColumns && dilogic - 1 < kDilogics && channel < kChannelsPerDilogic && word != previous;
+  const int32_t index = ((column - 1) * kDilogics + (dilogic - 1)) * kChannelsPerDilogic + channel;
+  return isPad ? index : -1;
+}
+
+} // namespace
+
+HmpidSuperpageDecoder::HmpidSuperpageDecoder()
+  : mSamples(kNChannels, 0), mSum(kNChannels, 0), mSquares(kNChannels, 0)
+{
+  // The standard definition of HMPID equipments at P2
+  const int eqIds[] = { 0, 1, 2, 3, 4, 5, 8, 9, 6, 7, 10, 11, 12, 13 };
+  const int cruIds[] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 3, 3 };
+  const int linkIds[] = { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 0, 1, 2 };
+
+  for (auto& links : mEquipmentIds) {
+    links.fill(-1);
+  }
+  for (int i = 0; i < kNEquipments; i++) {
+    mEquipmentIds[cruIds[i]][linkIds[i]] = eqIds[i];
+  }
+}
+
+bool HmpidSuperpageDecoder::decode(gsl::span<const char> superpage)
+{
+  bool success = true;
+  size_t position = 0;
+  while (position + kMinimumHeaderSize <= superpage.size()) {
+    const auto* page = reinterpret_cast<const uint32_t*>(superpage.data() + position);
+    const uint32_t headerSize = (page[0] & 0x0000ff00) >> 8;
+    const uint32_t offsetToNext = page[2] & 0x0000ffff;
+    const uint32_t memorySize = (page[2] & 0xffff0000) >> 16;
+    const uint32_t cruId = (page[3] & 0x00ff0000) >> 16;
+    const uint32_t linkId = page[3] & 0x000000ff;
+
+    if (headerSize < kMinimumHeaderSize || memorySize < headerSize || offsetToNext < memorySize || position + offsetToNext > superpage.size()) {
+      // we cannot know where the next page starts
+      mNumberOfErrors++;
+      return false;
+    }
+
+    const int equipment = (cruId < kNCrus && linkId < kNLinks) ? mEquipmentIds[cruId][linkId] : -1;
+    if (equipment < 0) {
+      mNumberOfErrors++;
+      success = false;
+    } else {
+      // the event is identified by the orbit
+      auto& statistics = mEquipments[equipment];
+      const uint32_t orbit = page[5];
+      if (statistics.numberOfEvents == 0 || orbit != statistics.orbit) {
+        statistics.orbit = orbit;
+        statistics.numberOfEvents++;
+        statistics.busyTimeSum += ((page[12] & 0xfffffe00) >> 9) * kBusyTimeUnit;
+      }
+      statistics.eventSizeSum += memorySize - headerSize;
+      decodePayload(page + headerSize / sizeof(uint32_t), (memorySize - headerSize) / sizeof(uint32_t), equipment);
+    }
+    position += offsetToNext;
+  }
+  return success;
+}
+
+void HmpidSuperpageDecoder::decodePayload(const uint32_t* words, size_t numberOfWords, int equipment)
+{
+  constexpr size_t chunkSize = 256;
+  std::array<int32_t, chunkSize> channels;
+  uint32_t* samples = mSamples.data() + equipment * kNChannelsPerEquipment;
+  uint64_t* sum = mSum.data() + equipment * kNChannelsPerEquipment;
+  uint64_t* squares = mSquares.data() + equipment * kNChannelsPerEquipment;
+
+  uint32_t previous = 0;
+  for (size_t first = 0; first < numberOfWords; first += chunkSize) {
+    const uint32_t* chunk = words + first;
+    const size_t size = std::min(chunkSize, numberOfWords - first);
+
+    channels[0] = classify(chunk[0], previous);
+    for (size_t i = 1; i < size; i++) {
+      channels[i] = classify(chunk[i], chunk[i - 1]);
+    }
+    previous = chunk[size - 1];
+
+    for (size_t i = 0; i < size; i++) {
+      if (channels[i] >= 0) {
+        const uint64_t charge = chunk[i] & 0x00000fff;
+        samples[channels[i]]++;
+        sum[channels[i]] += charge;
+        squares[channels[i]] += charge * charge;
+      }
+    }
+  }
+}
+
+void HmpidSuperpageDecoder::reset()
+{
+  std::fill(mSamples.begin(), mSamples.end(), 0);
+  std::fill(mSum.begin(), mSum.end(), 0);
+  std::fill(mSquares.begin(), mSquares.end(), 0);
+  mEquipments.fill({});
+  mNumberOfErrors = 0;
+}
+
+float HmpidSuperpageDecoder::getAverageEventSize(int equipment) const
+{
+  const auto& statistics = mEquipments[equipment];
+  return statistics.numberOfEvents > 0 ? statistics.eventSizeSum / statistics.numberOfEvents : 0.;
+}
+
+float HmpidSuperpageDecoder::getAverageBusyTime(int equipment) const
+{
+  const auto& statistics = mEquipments[equipment];
+  return statistics.numberOfEvents > 0 ? statistics.busyTimeSum / statistics.numberOfEvents : 0.;
+}
+
+} // namespace o2::quality_control_modules::hmpid
@@ -21,8 +21,6 @@
 #include "QualityControl/QcInfoLogger.h"
 //#include "HMPID/HmpidDecodeRawMem.h"
 #include "HMPID/HmpidTask.h"
-#include "HMPIDReconstruction/HmpidEquipment.h"
-#include "HMPIDReconstruction/HmpidDecoder2.h"
 
 namespace o2::quality_control_modules::hmpid
 {
@@ -46,8 +44,6 @@ HmpidTask::~HmpidTask()
   }
 }
 
-Int_t NumCycles = 0;
-
 void HmpidTask::initialize(o2::framework::InitContext& /*ctx*/)
 {
   ILOG(Info) << "initialize HmpidTask" << ENDM; // QcInfoLogger is used. FairMQ logs will go to there as well.
@@ -86,6 +82,8 @@ void HmpidTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   getObjectsManager()->startPublishing(hEventSize);
   getObjectsManager()->addMetadata(hEventSize->GetName(), "custom", "34");
+
+  mDecoder = std::make_unique<HmpidSuperpageDecoder>();
 }
 
 void HmpidTask::startOfActivity(Activity& /*activity*/)
@@ -95,82 +93,60 @@ void HmpidTask::startOfActivity(Activity& /*activity*/)
   hPedestalSigma->Reset();
   hBusyTime->Reset();
   hEventSize->Reset();
-
-  mDecoder = new o2::hmpid::HmpidDecoder2(14);
-  mDecoder->init();
-  mDecoder->setVerbosity(2); // this is for Debug
 }
 
 void HmpidTask::startOfCycle()
 {
   ILOG(Info) << "startOfCycle" << ENDM;
+  mDecoder->reset();
 }
 
 void HmpidTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  NumCycles++;
-  mDecoder->init();
-  mDecoder->setVerbosity(2); // this is for Debug
-
+  // the samples are accumulated by the decoder during the cycle, the histograms are filled at its end
   for (auto&& input : ctx.inputs()) {
     // get message header
     if (input.header != nullptr && input.payload != nullptr) {
       const auto* header = header::get<header::DataHeader*>(input.header);
-      int32_t* ptrToPayload = (int32_t*)(input.payload);
 
       if (header->payloadSize < 80) {
         continue;
       }
-      mDecoder->setUpStream(ptrToPayload, (long int)header->payloadSize);
-      if (!mDecoder->decodeBufferFast()) {
+      if (!mDecoder->decode(gsl::span<const char>(input.payload, header->payloadSize))) {
         ILOG(Error) << "Error decoding the Superpage !" << ENDM;
       }
-      for (Int_t eq = 0; eq < 14; eq++) {
-        if (mDecoder->getAverageEventSize(eq) > 0.) {
-          hEventSize->SetBinContent(eq + 1, mDecoder->getAverageEventSize(eq) / 1000.);
-          hEventSize->SetBinError(eq + 1, 0.0000001);
-        }
-        if (mDecoder->getAverageBusyTime(eq) > 0.) {
-          hBusyTime->SetBinContent(eq + 1, mDecoder->getAverageBusyTime(eq) * 1000000);
-          hBusyTime->SetBinError(eq + 1, 0.00000001);
-        }
-        Printf("eq = %i, size = %f, busy = %f", eq, mDecoder->getAverageEventSize(eq), mDecoder->getAverageBusyTime(eq));
-        for (Int_t column = 0; column < 24; column++) {
-          for (Int_t dilogic = 0; dilogic < 10; dilogic++) {
-            for (Int_t channel = 0; channel < 48; channel++) {
-              Float_t mean = mDecoder->getChannelSum(eq, column, dilogic, channel) / mDecoder->getChannelSamples(eq, column, dilogic, channel);
-              Float_t sigma = TMath::Sqrt(mDecoder->getChannelSquare(eq, column, dilogic, channel) / mDecoder->getChannelSamples(eq, column, dilogic, channel) - mean * mean);
-              hPedestalMean->Fill(mean);
-              hPedestalSigma->Fill(sigma);
-            }
-          }
-        }
-      }
-
-      /* Access the pads
-      uint16_t   decoder.theEquipments[0..13]->padSamples[0..23][0..9][0..47]  Number of samples
-      float      decoder.theEquipments[0..13]->padSum[0..23][0..9][0..47]      Sum of the charge of all samples
-      float      decoder.theEquipments[0..13]->padSquares[0..23][0..9][0..47]  Sum of the charge squares of all samples
-'     uint16_t GetChannelSamples(int Equipment, int Column, int Dilogic, int Channel);
-      float GetChannelSum(int Equipment, int Column, int Dilogic, int Channel);
-      float GetChannelSquare(int Equipment, int Column, int Dilogic, int Channel);
-      uint16_t GetPadSamples(int Module, int Column, int Row);
-      float GetPadSum(int Module, int Column, int Row);
-      float GetPadSquares(int Module, int Column, int Row);
-      */
     }
   }
-
-  if (NumCycles > 50) {
-    hPedestalMean->Reset();
-    hPedestalSigma->Reset();
-    NumCycles = 0;
-  }
 }
 
 void HmpidTask::endOfCycle()
 {
   ILOG(Info) << "endOfCycle" << ENDM;
+
+  for (Int_t eq = 0; eq < HmpidSuperpageDecoder::kNEquipments; eq++) {
+    if (mDecoder->getAverageEventSize(eq) > 0.) {
+      hEventSize->SetBinContent(eq + 1, mDecoder->getAverageEventSize(eq) / 1000.);
+      hEventSize->SetBinError(eq + 1, 0.0000001);
+    }
+    if (mDecoder->getAverageBusyTime(eq) > 0.) {
+      hBusyTime->SetBinContent(eq + 1, mDecoder->getAverageBusyTime(eq) * 1000000);
+      hBusyTime->SetBinError(eq + 1, 0.00000001);
+    }
+  }
+
+  // one entry per channel which received samples during the cycle
+  hPedestalMean->Reset();
+  hPedestalSigma->Reset();
+  for (Int_t index = 0; index < HmpidSuperpageDecoder::kNChannels; index++) {
+    auto samples = mDecoder->getChannelSamples(index);
+    if (samples == 0) {
+      continue;
+    }
+    Double_t mean = mDecoder->getChannelSum(index) / samples;
+    Double_t sigma = TMath::Sqrt(TMath::Max(0., mDecoder->getChannelSquare(index) / samples - mean * mean));
+    hPedestalMean->Fill(mean);
+    hPedestalSigma->Fill(sigma);
+  }
 }
 
 void HmpidTask::endOfActivity(Activity& /*activity*/)
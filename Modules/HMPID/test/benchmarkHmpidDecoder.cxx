@@ -0,0 +1,123 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkHmpidDecoder.cxx
+/// \author Piotr Konopka
+///
+
+#include "HMPID/HmpidSuperpageDecoder.h"
+#include "HMPIDReconstruction/HmpidDecoder2.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace o2::quality_control_modules::hmpid;
+
+// Compares the decoding of a superpage by HmpidSuperpageDecoder with o2::hmpid::HmpidDecoder2::decodeBufferFast(),
+// which was used by HmpidTask before. A superpage recorded with the readout can be given as the last argument,
+// otherwise a synthetic one with pedestal data of all the equipments is generated:
+//   benchmarkQcHMPIDDecoder [--benchmark_...] [superpage.raw]
+
+namespace
+{
+
+constexpr uint32_t pageSize = 8192;
+constexpr uint32_t headerSize = 64;
+
+std::vector<char> superpage;
+
+void generateSuperpage(size_t numberOfPagesPerEquipment)
+{
+  const uint32_t cruIds[] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 3, 3 };
+  const uint32_t linkIds[] = { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 0, 1, 2 };
+  std::mt19937 generator(42);
+  std::normal_distribution<float> pedestal(50, 2);
+
+  std::vector<uint32_t> words;
+  for (size_t page = 0; page < numberOfPagesPerEquipment; page++) {
+    for (size_t equipment = 0; equipment < HmpidSuperpageDecoder::kNEquipments; equipment++) {
+      const size_t first = words.size();
+      words.resize(first + pageSize / sizeof(uint32_t), 0);
+      uint32_t* header = words.data() + first;
+      header[0] = (headerSize << 8) | 6;
+      header[2] = (pageSize << 16) | pageSize;
+      header[3] = (cruIds[equipment] << 16) | linkIds[equipment];
+      header[5] = page / 4; // a few pages per event
+      header[12] = 2000 << 9;
+
+      uint32_t* payload = header + headerSize / sizeof(uint32_t);
+      const uint32_t numberOfWords = (pageSize - headerSize) / sizeof(uint32_t);
+      for (uint32_t i = 0; i < numberOfWords; i++) {
+        const uint32_t pad = (page * numberOfWords + i) % HmpidSuperpageDecoder::kNChannelsPerEquipment;
+        const uint32_t column = pad / (10 * 48) + 1;
+        const uint32_t dilogic = (pad / 48) % 10 + 1;
+        const uint32_t channel = pad % 48;
+        const auto charge = static_cast<uint32_t>(std::max(0.f, pedestal(generator))) & 0xfff;
+        payload[i] = (column << 22) | (dilogic << 18) | (channel << 12) | charge;
+      }
+    }
+  }
+  superpage.resize(words.size() * sizeof(uint32_t));
+  std::memcpy(superpage.data(), words.data(), superpage.size());
+}
+
+} // namespace
+
+static void BM_HmpidSuperpageDecoder(benchmark::State& state)
+{
+  HmpidSuperpageDecoder decoder;
+  for (auto _ : state) {
+    decoder.reset();
+    benchmark::DoNotOptimize(decoder.decode(gsl::span<const char>(superpage.data(), superpage.size())));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * superpage.size());
+}
+
+static void BM_HmpidDecoder2(benchmark::State& state)
+{
+  o2::hmpid::HmpidDecoder2 decoder(HmpidSuperpageDecoder::kNEquipments);
+  for (auto _ : state) {
+    decoder.init();
+    decoder.setUpStream(superpage.data(), static_cast<long>(superpage.size()));
+    benchmark::DoNotOptimize(decoder.decodeBufferFast());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * superpage.size());
+}
+
+BENCHMARK(BM_HmpidSuperpageDecoder);
+BENCHMARK(BM_HmpidDecoder2);
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      std::cerr << "Could not open the superpage file " << argv[1] << std::endl;
+      return 1;
+    }
+    superpage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  } else {
+    generateSuperpage(16);
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -14,6 +14,10 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "HMPID/HmpidSuperpageDecoder.h"
+
+#include <cstring>
+#include <vector>
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -26,4 +30,66 @@ namespace o2::quality_control_modules::hmpid
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+namespace
+{
+// a page with a RDH v6 header of 64 bytes followed by the payload
+std::vector<uint32_t> makePage(uint32_t cru, uint32_t link, uint32_t orbit, const std::vector<uint32_t>& payload)
+{
+  const uint32_t size = 64 + payload.size() * sizeof(uint32_t);
+  std::vector<uint32_t> page(16, 0);
+  page[0] = (64 << 8) | 6;
+  page[2] = (size << 16) | size;
+  page[3] = (cru << 16) | link;
+  page[5] = orbit;
+  page[12] = 20 << 9;
+  page.insert(page.end(), payload.begin(), payload.end());
+  return page;
+}
+
+uint32_t makePad(uint32_t column, uint32_t dilogic, uint32_t channel, uint32_t charge)
+{
+  return (column << 22) | (dilogic << 18) | (channel << 12) | charge;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(superpage_decoder)
+{
+  std::vector<uint32_t> words;
+  // equipment 0: the repeated word and the markers are not samples
+  auto page = makePage(0, 0, 1, { makePad(1, 1, 0, 10), makePad(1, 1, 0, 10), makePad(1, 1, 0, 20), 0x08000000, makePad(24, 10, 47, 3) });
+  words.insert(words.end(), page.begin(), page.end());
+  // equipment 8 is on CRU 1, link 2
+  page = makePage(1, 2, 1, { makePad(2, 3, 4, 5) });
+  words.insert(words.end(), page.begin(), page.end());
+  // a second page of the same event of equipment 0
+  page = makePage(0, 0, 1, { makePad(1, 1, 0, 30) });
+  words.insert(words.end(), page.begin(), page.end());
+
+  std::vector<char> superpage(words.size() * sizeof(uint32_t));
+  std::memcpy(superpage.data(), words.data(), superpage.size());
+
+  HmpidSuperpageDecoder decoder;
+  BOOST_CHECK(decoder.decode(gsl::span<const char>(superpage.data(), superpage.size())));
+  BOOST_CHECK_EQUAL(decoder.getNumberOfErrors(), 0);
+  BOOST_CHECK_EQUAL(decoder.getChannelSamples(0, 0, 0, 0), 3);
+  BOOST_CHECK_EQUAL(decoder.getChannelSum(0, 0, 0, 0), 60);
+  BOOST_CHECK_EQUAL(decoder.getChannelSquare(0, 0, 0, 0), 1400);
+  BOOST_CHECK_EQUAL(decoder.getChannelSamples(0, 23, 9, 47), 1);
+  BOOST_CHECK_EQUAL(decoder.getChannelSamples(8, 1, 2, 4), 1);
+  BOOST_CHECK_EQUAL(decoder.getChannelSum(8, 1, 2, 4), 5);
+  BOOST_CHECK_EQUAL(decoder.getAverageEventSize(0), 6 * sizeof(uint32_t));
+  BOOST_CHECK_CLOSE(decoder.getAverageBusyTime(0), 1e-6, 0.01);
+  BOOST_CHECK_EQUAL(decoder.getAverageEventSize(1), 0);
+
+  // a page of an unknown link is skipped
+  page = makePage(3, 3, 2, { makePad(1, 1, 0, 10) });
+  BOOST_CHECK(!decoder.decode(gsl::span<const char>(reinterpret_cast<const char*>(page.data()), page.size() * sizeof(uint32_t))));
+  BOOST_CHECK_EQUAL(decoder.getNumberOfErrors(), 1);
+  BOOST_CHECK_EQUAL(decoder.getChannelSamples(0, 0, 0, 0), 3);
+
+  decoder.reset();
+  BOOST_CHECK_EQUAL(decoder.getChannelSamples(0, 0, 0, 0), 0);
+  BOOST_CHECK_EQUAL(decoder.getNumberOfErrors(), 0);
+}
+
 } // namespace o2::quality_control_modules::hmpid
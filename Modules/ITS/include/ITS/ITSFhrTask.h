@@ -85,7 +85,20 @@ class ITSFhrTask final : public TaskInterface
   std::array<bool, NLayer> mEnableLayers = { false };
 
   int mNThreads = 0;
-  std::unordered_map<unsigned int, int> mHitPixelID_Hash[7][48][2][14][14]; //layer, stave, substave, hic, chip
+  /// Hit counts of the pixels of a chip, kept in vectors sorted by pixel id (column * NRows + row).
+  /// The hits of a TF are collected first and merged at once, the pixels they touched are exported afterwards.
+  struct ChipHits {
+    std::vector<uint32_t> pixels;
+    std::vector<int> counts;
+    std::vector<uint32_t> pending; // pixels hit in the current TF, not merged yet
+    std::vector<uint32_t> updated; // pixels whose count changed since they were last exported
+    void merge();
+    void mergeNew(const std::vector<uint32_t>& hit, const std::vector<int>& increments);
+    int count(uint32_t pixel) const;
+    void clear();
+  };
+  ChipHits mChipHits[7][48][2][14][14]; //layer, stave, substave, hic, chip
+  std::vector<ChipHits*> mChipsWithPendingHits;
 
   o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>* mDecoder;
   ChipPixelData* mChipDataBuffer = nullptr;
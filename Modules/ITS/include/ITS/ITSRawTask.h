@@ -14,6 +14,8 @@
 #include <TH2F.h>
 #include <TPaveText.h>
 #include <TEllipse.h>
+#include <Common/Timer.h>
+#include <cstdint>
 #include <ITSMFTReconstruction/RawPixelReader.h>
 #include <ITSBase/GeometryTGeo.h>
 #include <ITSMFTReconstruction/DigitPixelReader.h>
@@ -159,15 +161,25 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   const int NFiles = 24;
   TEllipse* bulb;
 
-  int mTotalDigits = 0;
+  uint64_t mTotalDigits = 0;               // since the start, sent as a rate
+  AliceO2::Common::Timer mMonitoringTimer; // the metrics are sent periodically
   int mNEvent;
   int mNEventPre;
   int mTotalFileDone;
   //	int FileRest;
 
-  int mCounted;
-  int mTotalCounted = 10000;
   int mYellowed;
+
+  /// Position of a chip in the detector, looked up once in the geometry
+  struct ChipPosition {
+    int layer = 0;
+    int stave = 0;
+    int module = 0;
+    int chip = 0;
+    float eta = 0; // of the chip centre
+    float phi = 0;
+  };
+  std::vector<ChipPosition> mChipPositions; // indexed by ChipID
 };
 
 } // namespace its
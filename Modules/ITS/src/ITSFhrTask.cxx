@@ -20,6 +20,8 @@
 #include <DPLUtils/RawParser.h>
 #include <DPLUtils/DPLRawParser.h>
 
+#include <algorithm>
+
 using namespace o2::framework;
 using namespace o2::itsmft;
 using namespace o2::header;
@@ -348,14 +350,14 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   while ((mChipDataBuffer = mDecoder->getNextChipData(mChipsBuffer))) {
     if (mChipDataBuffer) {
       const auto& pixels = mChipDataBuffer->getData();
+      mGeom->getChipId(mChipDataBuffer->getChipID(), lay, sta, ssta, mod, chip);
+      mHitNumberOfChip[lay][sta][ssta][mod][chip] += pixels.size();
+      auto& chipHits = mChipHits[lay][sta][ssta][mod][chip];
+      if (chipHits.pending.empty() && !pixels.empty()) {
+        mChipsWithPendingHits.push_back(&chipHits);
+      }
       for (auto& pixel : pixels) {
-        mGeom->getChipId(mChipDataBuffer->getChipID(), lay, sta, ssta, mod, chip);
-        mHitNumberOfChip[lay][sta][ssta][mod][chip]++;
-        if (mHitPixelID_Hash[lay][sta][ssta][mod][chip].find(pixel.getCol() * 1000 + pixel.getRow()) == mHitPixelID_Hash[lay][sta][ssta][mod][chip].end()) {
-          mHitPixelID_Hash[lay][sta][ssta][mod][chip][pixel.getCol() * 1000 + pixel.getRow()] = 1;
-        } else {
-          mHitPixelID_Hash[lay][sta][ssta][mod][chip][pixel.getCol() * 1000 + pixel.getRow()]++;
-        }
+        chipHits.pending.push_back(pixel.getCol() * NRows + pixel.getRow());
       }
       if (lay < NLayerIB) {
         if (pixels.size() > 100) {
@@ -369,6 +371,11 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
+  for (auto* chipHits : mChipsWithPendingHits) {
+    chipHits->merge();
+  }
+  mChipsWithPendingHits.clear();
+
   end = std::chrono::high_resolution_clock::now();
   difference = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
   ILOG(Info) << "time untile decode over " << difference << ENDM;
@@ -402,11 +409,15 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
           for (int ichip = 0 + (ilink * 3); ichip < (ilink * 3) + 3; ichip++) {
             if ((GBTLinkInfo->statistics.nTriggers > 0) && (mHitNumberOfChip[ilayer][istave][0][0][ichip] >= 0)) {
               mChipStaveOccupancy[ilayer]->SetBinContent(ichip + 1, istave + 1, (mHitNumberOfChip[ilayer][istave][0][0][ichip]) / (GBTLinkInfo->statistics.nTriggers * 1024. * 512.));
-              std::unordered_map<unsigned int, int>::iterator iter;
-              for (iter = mHitPixelID_Hash[ilayer][istave][0][0][ichip].begin(); iter != mHitPixelID_Hash[ilayer][istave][0][0][ichip].end(); iter++) {
-                int pixelPos[2] = { (int)(iter->first / 1000) + (int)ichip * 1024, (int)(iter->first % 1000) };
-                mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, (double)iter->second);
-                double pixelOccupancy = (double)iter->second;
+              auto& chipHits = mChipHits[ilayer][istave][0][0][ichip];
+              // only the pixels hit in this TF have a new content in the hitmap
+              for (auto pixel : chipHits.updated) {
+                int pixelPos[2] = { (int)(pixel / NRows) + (int)ichip * 1024, (int)(pixel % NRows) };
+                mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, (double)chipHits.count(pixel));
+              }
+              chipHits.updated.clear();
+              for (auto count : chipHits.counts) {
+                double pixelOccupancy = (double)count;
                 pixelOccupancy /= GBTLinkInfo->statistics.nTriggers;
                 mOccupancyPlot[ilayer]->Fill(log10(pixelOccupancy));
               }
@@ -419,19 +430,25 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
             for (int ichip = 0; ichip < nChipsPerHic[ilayer]; ichip++) {
               chipOccupancy += mHitNumberOfChip[ilayer][istave][isubstave][ihic][ichip];
               if ((GBTLinkInfo->statistics.nTriggers > 0) && (mHitNumberOfChip[ilayer][istave][ilink][ihic][ichip] >= 0)) {
-                if (mHitPixelID_Hash[ilayer][istave][ilink][ihic][ichip].size() == 0) {
+                auto& chipHits = mChipHits[ilayer][istave][isubstave][ihic][ichip];
+                if (chipHits.pixels.empty()) {
                   continue;
                 }
-                std::unordered_map<unsigned int, int>::iterator iter;
-                for (iter = mHitPixelID_Hash[ilayer][istave][isubstave][ihic][ichip].begin(); iter != mHitPixelID_Hash[ilayer][istave][isubstave][ihic][ichip].end(); iter++) {
-                  double pixelOccupancy = (double)iter->second;
+                // only the pixels hit in this TF have a new content in the hitmap
+                for (auto pixel : chipHits.updated) {
+                  int col = pixel / NRows;
+                  int row = pixel % NRows;
                   if (ichip < 7) {
-                    int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + ichip * NCols + (int)(iter->first / 1000) + 1, NRows - ((int)iter->first % 1000) - 1 + (1024 * isubstave) + 1 };
-                    mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, pixelOccupancy);
+                    int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + ichip * NCols + col + 1, NRows - row - 1 + (1024 * isubstave) + 1 };
+                    mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, (double)chipHits.count(pixel));
                   } else {
-                    int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + (nChipsPerHic[lay] / 2) * NCols - (ichip - 7) * NCols - ((int)iter->first / 1000) + 1, NRows + ((int)iter->first % 1000) + (1024 * isubstave) + 1 };
-                    mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, pixelOccupancy);
+                    int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + (nChipsPerHic[lay] / 2) * NCols - (ichip - 7) * NCols - col + 1, NRows + row + (1024 * isubstave) + 1 };
+                    mStaveHitmap[ilayer][istave]->SetBinContent(pixelPos, (double)chipHits.count(pixel));
                   }
+                }
+                chipHits.updated.clear();
+                for (auto count : chipHits.counts) {
+                  double pixelOccupancy = (double)count;
                   pixelOccupancy /= GBTLinkInfo->statistics.nTriggers;
                   mOccupancyPlot[ilayer]->Fill(log10(pixelOccupancy));
                 }
@@ -536,9 +553,100 @@ void ITSFhrTask::resetGeneralPlots()
   mInfoCanvasOBComm->Reset();
 }
 
+void ITSFhrTask::ChipHits::merge()
+{
+  std::sort(pending.begin(), pending.end());
+  // the pixels hit in the TF, with their number of hits
+  std::vector<uint32_t> hit;
+  std::vector<int> increments;
+  for (auto pixel : pending) {
+    if (hit.empty() || hit.back() != pixel) {
+      hit.push_back(pixel);
+      increments.push_back(1);
+    } else {
+      increments.back()++;
+    }
+  }
+  pending.clear();
+  // they stay to be exported until the hitmap is updated, which might not happen at each TF
+  updated.insert(updated.end(), hit.begin(), hit.end());
+
+  // in noise runs, the same pixels fire again and again, so that most of the time they are all known already
+  bool allKnown = true;
+  std::vector<size_t> positions(hit.size());
+  for (size_t i = 0; i < hit.size() && allKnown; i++) {
+    positions[i] = std::lower_bound(pixels.begin(), pixels.end(), hit[i]) - pixels.begin();
+    allKnown = positions[i] < pixels.size() && pixels[positions[i]] == hit[i];
+  }
+  if (allKnown) {
+    for (size_t i = 0; i < hit.size(); i++) {
+      counts[positions[i]] += increments[i];
+    }
+  } else {
+    mergeNew(hit, increments);
+  }
+  if (updated.size() > pixels.size()) {
+    // the hitmap was not updated for a while, all the pixels are exported at once
+    updated = pixels;
+  }
+}
+
+void ITSFhrTask::ChipHits::mergeNew(const std::vector<uint32_t>& hit, const std::vector<int>& increments)
+{
+  std::vector<uint32_t> mergedPixels;
+  std::vector<int> mergedCounts;
+  mergedPixels.reserve(pixels.size() + hit.size());
+  mergedCounts.reserve(pixels.size() + hit.size());
+  size_t i = 0, j = 0;
+  while (i < pixels.size() || j < hit.size()) {
+    if (j == hit.size() || (i < pixels.size() && pixels[i] < hit[j])) {
+      mergedPixels.push_back(pixels[i]);
+      mergedCounts.push_back(counts[i]);
+      i++;
+    } else if (i == pixels.size() || hit[j] < pixels[i]) {
+      mergedPixels.push_back(hit[j]);
+      mergedCounts.push_back(increments[j]);
+      j++;
+    } else {
+      mergedPixels.push_back(pixels[i]);
+      mergedCounts.push_back(counts[i] + increments[j]);
+      i++;
+      j++;
+    }
+  }
+  pixels.swap(mergedPixels);
+  counts.swap(mergedCounts);
+}
+
+int ITSFhrTask::ChipHits::count(uint32_t pixel) const
+{
+  auto position = std::lower_bound(pixels.begin(), pixels.end(), pixel);
+  return (position != pixels.end() && *position == pixel) ? counts[position - pixels.begin()] : 0;
+}
+
+void ITSFhrTask::ChipHits::clear()
+{
+  pixels.clear();
+  counts.clear();
+  pending.clear();
+  updated.clear();
+}
+
 void ITSFhrTask::resetOccupancyPlots()
 {
   memset(mHitNumberOfChip, 0, sizeof(mHitNumberOfChip));
+  for (auto& layer : mChipHits) {
+    for (auto& stave : layer) {
+      for (auto& substave : stave) {
+        for (auto& hic : substave) {
+          for (auto& chipHits : hic) {
+            chipHits.clear();
+          }
+        }
+      }
+    }
+  }
+  mChipsWithPendingHits.clear();
   memset(mTriggerTypeCount, 0, sizeof(mTriggerTypeCount));
   memset(mErrors, 0, sizeof(mErrors));
   mTimeFrameId = 0;
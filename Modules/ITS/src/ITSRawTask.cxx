@@ -104,6 +104,18 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
   QcInfoLogger::GetInstance() << "numOfChips = " << numOfChips << AliceO2::InfoLogger::InfoLogger::endm;
   setNChips(numOfChips);
 
+  // the position of the chips does not change, so it is looked up in the geometry only once
+  mChipPositions.resize(numOfChips);
+  for (int chipID = 0; chipID < numOfChips; chipID++) {
+    auto& position = mChipPositions[chipID];
+    int subStave;
+    geom->getChipId(chipID, position.layer, position.stave, subStave, position.module, position.chip);
+    const math_utils::Point3D<float> loc(0., 0., 0.);
+    auto glo = geom->getMatrixL2G(chipID)(loc);
+    position.eta = glo.eta();
+    position.phi = glo.phi();
+  }
+
   for (int i = 0; i < NError; i++) {
     pt[i] = new TPaveText(0.20, 0.80 - i * 0.05, 0.85, 0.85 - i * 0.05, "NDC");
     formatPaveText(pt[i], 0.04, gStyle->GetTextColor(), 12, ErrorType[i].Data());
@@ -152,8 +164,8 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
   bulb->SetFillColor(kRed);
   mTotalFileDone = 0;
   TotalHisTime = 0;
-  mCounted = 0;
   mYellowed = 0;
+  mMonitoringTimer.reset(10000000); // 10 s.
 }
 
 void ITSRawTask::startOfActivity(Activity& /*activity*/)
@@ -168,8 +180,6 @@ void ITSRawTask::startOfCycle()
 
 void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  double eta, phi;
-  int lay, sta, ssta, mod, chip;
   UShort_t col = 0, row = 0, ChipID = 0;
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> startLoop;
@@ -178,10 +188,6 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
 
   start = std::chrono::high_resolution_clock::now();
 
-  ofstream timefout("HisTimeGlobal.dat", ios::app);
-
-  ofstream timefout2("HisTimeLoop.dat", ios::app);
-
   QcInfoLogger::GetInstance() << "BEEN HERE BRO" << AliceO2::InfoLogger::InfoLogger::endm;
 
   int FileID = ctx.inputs().get<int>("File");
@@ -201,6 +207,7 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
   auto digits = ctx.inputs().get<const std::vector<o2::itsmft::Digit>>("digits");
   auto events = ctx.inputs().get<DigitEvent*>("Events");
   LOG(INFO) << "Digit Size Getting For This TimeFrame (Event) = " << digits.size();
+  const size_t nDigits = digits.size();
 
   mErrors = ctx.inputs().get<const std::array<unsigned int, NError>>("Error");
 
@@ -221,13 +228,9 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  //	QcInfoLogger::GetInstance() << "Before Loop = " << difference/1000.0 << "s" <<  AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Before Loop  = " << difference / 1000.0 << "s" << std::endl;
+  startLoop = std::chrono::high_resolution_clock::now();
   int i = 0;
   for (auto&& pixeldata : digits) {
-    startLoop = std::chrono::high_resolution_clock::now();
-
     ChipID = pixeldata.getChipIndex();
     col = pixeldata.getColumn();
     row = pixeldata.getRow();
@@ -241,14 +244,6 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
       // cout << "Carried out, " << NEventPre << endl;
     }
 
-    // cout << "NFrame = " << NEvent  << endl;
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Getting Value Time  = " << difference << "ns" << std::endl;
-    }
-
     if (mNEvent % 1000000 == 0 && mNEvent > 0) {
       QcInfoLogger::GetInstance() << "ChipID = " << ChipID << "  col = " << col << "  row = " << row << "  mNEvent = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
     }
@@ -258,30 +253,19 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
       ptNEvent->AddText(Form("Event Being Processed: %d", mNEvent));
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before Geo  = " << difference << "ns" << std::endl;
+    if (ChipID >= mChipPositions.size()) {
+      continue;
     }
-
-    gm->getChipId(ChipID, lay, sta, ssta, mod, chip);
-    // cout << "getID : " << ChipID << ", " << lay << ", " << sta << ", " << ssta << ", " << mod << ", " << chip << endl;
-    gm->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G));
-    const math_utils::Point3D<float> loc(0., 0., 0.);
-    auto glo = gm->getMatrixL2G(ChipID)(loc);
+    const auto& position = mChipPositions[ChipID];
+    int lay = position.layer;
+    int sta = position.stave;
+    int mod = position.module;
+    int chip = position.chip;
 
     if (!mlayerEnable[lay]) {
       continue;
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After Geo =  " << difference << "ns" << std::endl;
-    }
-
     int hicCol, hicRow;
     // Todo: check if chipID is really chip ID
     getHicCoordinates(lay, chip, col, row, hicRow, hicCol);
@@ -295,36 +279,14 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
       // hIBHitmap[lay]->Fill(hicCol, row+(sta*NRowHis));
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Fill HitMaps =  " << difference << "ns" << std::endl;
-    }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before glo etaphi =  " << difference << "ns" << std::endl;
-    }
-
-    eta = glo.eta();
-    phi = glo.phi();
-    hEtaPhiHitmap[lay]->Fill(eta, phi);
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After glo etaphi =  " << difference << "ns" << std::endl;
-      mCounted = mCounted + 1;
-    }
+    hEtaPhiHitmap[lay]->Fill(position.eta, position.phi);
 
     mNEventPre = mNEvent;
 
   } // end digits loop
   i = 0;
+  end = std::chrono::high_resolution_clock::now();
+  auto loopTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
   if (mNEventPre > 0) {
     updateOccupancyPlots(mNEventPre);
   }
@@ -333,7 +295,6 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
   difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
   QcInfoLogger::GetInstance() << "Time After Loop = " << difference / 1000.0 << "s"
                               << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time After Loop = " << difference / 1000.0 << "s" << std::endl;
 
   QcInfoLogger::GetInstance() << "NEventDone = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
   QcInfoLogger::GetInstance() << "Test  " << AliceO2::InfoLogger::InfoLogger::endm;
@@ -345,7 +306,17 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
   TotalHisTime = TotalHisTime + difference;
   QcInfoLogger::GetInstance() << "Time in Histogram = " << difference / 1000.0 << "s"
                               << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time in Histogram = " << difference / 1000.0 << "s" << std::endl;
+
+  // the timing is published as metrics, instead of being appended to local files
+  mTotalDigits += nDigits;
+  if (mMonitoring && mMonitoringTimer.isTimeout()) {
+    mMonitoringTimer.reset(10000000); // 10 s.
+    mMonitoring->send({ mTotalDigits, "qc_its_raw_digits" }, o2::monitoring::DerivedMetricMode::RATE);
+    mMonitoring->send({ static_cast<double>(difference), "qc_its_raw_processing_time_ms" });
+    if (nDigits > 0) {
+      mMonitoring->send({ static_cast<double>(loopTime) / nDigits, "qc_its_raw_time_per_digit_ns" });
+    }
+  }
 
   if (mNEvent == 0 && ChipID == 0 && row == 0 && col == 0 && mYellowed == 0) {
     bulb->SetFillColor(kYellow);
@@ -16,6 +16,7 @@
 #include "MCHBase/Digit.h"
 #endif
 #include "MCH/GlobalHistogram.h"
+#include <vector>
 
 class TH1F;
 class TH2F;
@@ -52,7 +53,34 @@ class PhysicsTaskDigits /*final*/ : public TaskInterface // todo add back the "f
   void reset() override;
 
  private:
+  /// Bins of the histograms where a pad is drawn, computed once in initialize()
+  struct PadBins {
+    int elecBin = -1;   // global bin in the histograms in Elec view, -1 if the pad does not exist
+    int cathode = 0;    // 0 for bending, 1 for non-bending
+    short xMin = 0;     // range of XY bins covered by the pad in the DE histograms
+    short xMax = -1;
+    short yMin = 0;
+    short yMax = -1;
+    int solarBins = -1; // index in mSolarBins, -1 if the pad is not connected to any SOLAR board
+  };
+  /// Pads of a DE cathode read out by a SOLAR board, whose XY bins get the number of orbits of its link
+  struct SolarBins {
+    int de = 0;
+    TH2F* histogram = nullptr;
+    uint32_t feeId = 0;
+    uint32_t linkId = 0;
+    std::vector<int> pads;
+    bool hasDigits = false;
+  };
+  struct DEBins {
+    TH1F* adcAmplitude = nullptr;
+    TH2F* nhits[2] = { nullptr, nullptr };
+    std::vector<PadBins> pads; // indexed by pad id
+  };
+
+  void buildPadBins();
   void plotDigit(const o2::mch::Digit& digit);
+  void fillNorbitsXY();
 
   o2::mch::raw::Elec2DetMapper mElec2DetMapper;
   o2::mch::raw::Det2ElecMapper mDet2ElecMapper;
@@ -91,6 +119,9 @@ class PhysicsTaskDigits /*final*/ : public TaskInterface // todo add back the "f
 
   GlobalHistogram* mHistogramOccupancy[1];
   GlobalHistogram* mHistogramOrbits[1];
+
+  std::vector<DEBins> mDEBins; // indexed by DE id
+  std::vector<SolarBins> mSolarBins;
 };
 
 } // namespace muonchambers
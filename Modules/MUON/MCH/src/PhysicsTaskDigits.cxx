@@ -11,6 +11,8 @@
 #include <TH2.h>
 #include <TFile.h>
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 #include "MCH/PhysicsTaskDigits.h"
 #ifdef MCH_HAS_MAPPING_FACTORY
@@ -134,6 +136,83 @@ void PhysicsTaskDigits::initialize(o2::framework::InitContext& /*ctx*/)
   mHistogramOrbits[0]->init();
   mHistogramOrbits[0]->SetOption("colz");
   getObjectsManager()->startPublishing(mHistogramOrbits[0]);
+
+  buildPadBins();
+}
+
+void PhysicsTaskDigits::buildPadBins()
+{
+  // The mapping of each pad to the histogram bins does not change, so we compute it once here instead of for each digit
+  mDEBins.clear();
+  mDEBins.resize(1100);
+  mSolarBins.clear();
+  std::map<std::tuple<int, int, uint32_t>, int> solarBinsIndex; // (de, cathode, solar) -> index in mSolarBins
+
+  for (auto de : o2::mch::raw::deIdsForAllMCH) {
+    auto& deBins = mDEBins[de];
+    deBins.adcAmplitude = mHistogramADCamplitudeDE[de];
+    deBins.nhits[0] = mHistogramNhitsDE[0][de];
+    deBins.nhits[1] = mHistogramNhitsDE[1][de];
+
+    const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+    deBins.pads.resize(segment.nofPads());
+    segment.forEachPad([&](int padid) {
+      auto& pad = deBins.pads[padid];
+      pad.cathode = segment.isBendingPad(padid) ? 0 : 1;
+      int dsid = segment.padDualSampaId(padid);
+      int chan_addr = segment.padDualSampaChannel(padid);
+
+      uint32_t solar_id = 0;
+      uint32_t ds_addr = 0;
+      int32_t linkid = 0;
+      int32_t fee_id = 0;
+
+      // get the unique solar ID and the DS address associated to this pad
+      std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid });
+      if (dsElecId.has_value()) {
+        solar_id = dsElecId->solarId();
+        ds_addr = dsElecId->elinkId();
+
+        std::optional<FeeLinkId> feeLinkId = mSolar2FeeLinkMapper(solar_id);
+        if (feeLinkId.has_value()) {
+          fee_id = feeLinkId->feeId();
+          linkid = feeLinkId->linkId();
+        }
+      }
+
+      //xbin and ybin uniquely identify each physical pad
+      int xbin = fee_id * 12 * 40 + (linkid % 12) * 40 + ds_addr + 1;
+      int ybin = chan_addr + 1;
+      pad.elecBin = mHistogramNHitsElec->GetBin(xbin, ybin);
+
+      // XY bins covered by the pad
+      auto* h2 = deBins.nhits[pad.cathode];
+      double padX = segment.padPositionX(padid);
+      double padY = segment.padPositionY(padid);
+      float padSizeX = segment.padSizeX(padid);
+      float padSizeY = segment.padSizeY(padid);
+      pad.xMin = h2->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
+      pad.xMax = h2->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
+      pad.yMin = h2->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
+      pad.yMax = h2->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
+
+      if (!dsElecId.has_value()) {
+        return;
+      }
+      auto key = std::make_tuple(static_cast<int>(de), pad.cathode, solar_id);
+      auto index = solarBinsIndex.find(key);
+      if (index == solarBinsIndex.end()) {
+        index = solarBinsIndex.emplace(key, mSolarBins.size()).first;
+        auto& solarBins = mSolarBins.emplace_back();
+        solarBins.de = de;
+        solarBins.histogram = mHistogramNorbitsDE[pad.cathode][de];
+        solarBins.feeId = fee_id;
+        solarBins.linkId = linkid;
+      }
+      pad.solarBins = index->second;
+      mSolarBins[index->second].pads.push_back(padid);
+    });
+  }
 }
 
 void PhysicsTaskDigits::startOfActivity(Activity& /*activity*/)
@@ -186,49 +265,22 @@ void PhysicsTaskDigits::plotDigit(const o2::mch::Digit& digit)
   int de = digit.getDetID();
   int padid = digit.getPadID();
 
-  if (ADC < 0 || de <= 0 || padid < 0) {
+  if (ADC < 0 || de <= 0 || de >= static_cast<int>(mDEBins.size()) || padid < 0) {
     return;
   }
-
-  // Fill NHits Elec Histogram and ADC distribution
-  // Using the mapping to go from Digit info (de, pad) to Elec info (fee, link) and fill Elec Histogram, where one bin is one physical pad
-  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-
-  double padX = segment.padPositionX(padid);
-  double padY = segment.padPositionY(padid);
-  float padSizeX = segment.padSizeX(padid);
-  float padSizeY = segment.padSizeY(padid);
-  int cathode = segment.isBendingPad(padid) ? 0 : 1;
-  int dsid = segment.padDualSampaId(padid);
-  int chan_addr = segment.padDualSampaChannel(padid);
-
-  uint32_t solar_id = 0;
-  uint32_t ds_addr = 0;
-  int32_t linkid = 0;
-  int32_t fee_id = 0;
-
-  // get the unique solar ID and the DS address associated to this digit
-  std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid });
-  if (dsElecId.has_value()) {
-    solar_id = dsElecId->solarId();
-    ds_addr = dsElecId->elinkId();
-
-    std::optional<FeeLinkId> feeLinkId = mSolar2FeeLinkMapper(solar_id);
-    if (feeLinkId.has_value()) {
-      fee_id = feeLinkId->feeId();
-      linkid = feeLinkId->linkId();
-    }
+  const auto& deBins = mDEBins[de];
+  if (padid >= static_cast<int>(deBins.pads.size()) || deBins.pads[padid].elecBin < 0) {
+    return;
   }
+  const auto& pad = deBins.pads[padid];
 
-  //xbin and ybin uniquely identify each physical pad
-  int xbin = fee_id * 12 * 40 + (linkid % 12) * 40 + ds_addr + 1;
-  int ybin = chan_addr + 1;
-
-  mHistogramNHitsElec->Fill(xbin - 0.5, ybin - 0.5);
+  // Fill NHits Elec Histogram and ADC distribution
+  // The Elec info (fee, link) of the pad gives the bin of the Elec Histogram, where one bin is one physical pad
+  mHistogramNHitsElec->AddBinContent(pad.elecBin);
+  mHistogramNHitsElec->SetEntries(mHistogramNHitsElec->GetEntries() + 1);
 
-  auto h = mHistogramADCamplitudeDE.find(de);
-  if ((h != mHistogramADCamplitudeDE.end()) && (h->second != NULL)) {
-    h->second->Fill(ADC);
+  if (deBins.adcAmplitude != nullptr) {
+    deBins.adcAmplitude->Fill(ADC);
   }
 
   if (ADC <= 0) {
@@ -236,49 +288,35 @@ void PhysicsTaskDigits::plotDigit(const o2::mch::Digit& digit)
   }
 
   // Fill X Y 2D hits histogram with fired pads distribution
-  auto h2 = mHistogramNhitsDE[cathode].find(de);
-  if ((h2 != mHistogramNhitsDE[cathode].end()) && (h2->second != NULL)) {
-    int binx_min = h2->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-    int binx_max = h2->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-    int biny_min = h2->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-    int biny_max = h2->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-    for (int by = biny_min; by <= biny_max; by++) {
-      float y = h2->second->GetYaxis()->GetBinCenter(by);
-      for (int bx = binx_min; bx <= binx_max; bx++) {
-        float x = h2->second->GetXaxis()->GetBinCenter(bx);
-        h2->second->Fill(x, y);
+  auto* h2 = deBins.nhits[pad.cathode];
+  if (h2 != nullptr) {
+    for (int by = pad.yMin; by <= pad.yMax; by++) {
+      for (int bx = pad.xMin; bx <= pad.xMax; bx++) {
+        h2->AddBinContent(h2->GetBin(bx, by));
       }
     }
+    h2->SetEntries(h2->GetEntries() + (pad.xMax - pad.xMin + 1) * (pad.yMax - pad.yMin + 1));
   }
 
-  // Get the Elec information to fill histogram of orbits (XY histogram)
-  h2 = mHistogramNorbitsDE[cathode].find(de);
-  if ((h2 != mHistogramNorbitsDE[cathode].end()) && (h2->second != NULL)) {
-    int NYbins = h2->second->GetYaxis()->GetNbins();
-    int NXbins = h2->second->GetXaxis()->GetNbins();
-    for (int by = 0; by < NYbins; by++) {
-      float y = h2->second->GetYaxis()->GetBinCenter(by);
-      for (int bx = 0; bx < NXbins; bx++) {
-        float x = h2->second->GetXaxis()->GetBinCenter(bx);
-
-        // get pad and DS channel mappings for this bin
-        int bpad = 0;
-        int nbpad = 0;
-        uint32_t solar_id_boucle = 0;
-
-        if (segment.findPadPairByPosition(x, y, bpad, nbpad)) {
-
-          // get the unique solar ID and the DS address associated to this bin
-          int padid_boucle = (cathode == 0) ? bpad : nbpad;
-          int dsid_boucle = segment.padDualSampaId(padid_boucle);
-          std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid_boucle });
-          if (dsElecId.has_value()) {
-            solar_id_boucle = dsElecId->solarId();
-          }
+  // The histogram of orbits (XY histogram) is filled at the end of the cycle for the SOLAR boards which saw digits
+  if (pad.solarBins >= 0) {
+    mSolarBins[pad.solarBins].hasDigits = true;
+  }
+}
 
-          if (solar_id_boucle == solar_id) {
-            h2->second->SetBinContent(bx, by, norbits[fee_id][linkid]);
-          }
+void PhysicsTaskDigits::fillNorbitsXY()
+{
+  for (const auto& solarBins : mSolarBins) {
+    if (!solarBins.hasDigits || solarBins.histogram == nullptr) {
+      continue;
+    }
+    auto* h2 = solarBins.histogram;
+    const auto& pads = mDEBins[solarBins.de].pads;
+    for (auto padid : solarBins.pads) {
+      const auto& pad = pads[padid];
+      for (int by = pad.yMin; by <= pad.yMax; by++) {
+        for (int bx = pad.xMin; bx <= pad.xMax; bx++) {
+          h2->SetBinContent(bx, by, norbits[solarBins.feeId][solarBins.linkId]);
         }
       }
     }
@@ -298,6 +336,8 @@ void PhysicsTaskDigits::endOfCycle()
     }
   }
 
+  fillNorbitsXY();
+
   // Compute Occupancy in GlobalHistograms by dividing Hits by Orbits and scaling
   mHistogramOrbits[0]->set(mHistogramNorbitsDE[0], mHistogramNorbitsDE[1]);
   mHistogramOccupancy[0]->set(mHistogramNhitsDE[0], mHistogramNhitsDE[1]);
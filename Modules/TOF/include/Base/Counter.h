@@ -19,6 +19,11 @@
 #ifndef QC_MODULE_TOF_COUNTER_H
 #define QC_MODULE_TOF_COUNTER_H
 
+// STL includes
+#include <array>
+#include <atomic>
+#include <type_traits>
+
 // ROOT includes
 #include "TH1.h"
 #include "TMath.h"
@@ -32,9 +37,23 @@
 namespace o2::quality_control_modules::tof
 {
 
+/// \brief How a Counter is incremented, chosen at compile time
+enum class CounterMode {
+  Checked, ///< The index is checked and each increment is logged at debug level
+  Fast,    ///< Plain array increment, nothing is checked nor logged
+  Atomic   ///< Like Fast, but the counter can be incremented concurrently by several threads
+};
+
+/// Mode of the counters which do not specify it: they are checked only in debug builds
+#ifdef NDEBUG
+constexpr CounterMode defaultCounterMode = CounterMode::Fast;
+#else
+constexpr CounterMode defaultCounterMode = CounterMode::Checked;
+#endif
+
 /// \brief Class to count events
 /// \author Nicolo' Jacazio
-template <const unsigned int size, const char* labels[size]>
+template <const unsigned int size, const char* labels[size], CounterMode mode = defaultCounterMode>
 class Counter
 {
  public:
@@ -44,7 +63,7 @@ class Counter
   /// Destructor
   ~Counter() = default;
 
-  /// Functions to increment a counter
+  /// Functions to increment a counter. Only the Checked mode verifies the index.
   /// @param index Index in the counter array to increment
   /// @param weight weight to add to the array element
   void Add(const unsigned int& index, const uint32_t& weight);
@@ -97,7 +116,7 @@ class Counter
   static_assert(size > 0, "size of the counter cannot be 0!");
   // static_assert(((labels == nullptr) || (sizeof(labels) / sizeof(const char*)) == size), "size of the counter and the one of the labels must coincide");
   /// Containers to fill
-  std::array<uint32_t, size> counter = { 0 };
+  std::array<std::conditional_t<mode == CounterMode::Atomic, std::atomic<uint32_t>, uint32_t>, size> counter = { 0 };
   uint32_t mTotal = 0;
 };
 
@@ -107,18 +126,24 @@ class Counter
 
 // #define ENABLE_BIN_SHIFT // Flag used to enable different binning in counter and histograms
 
-template <const unsigned int size, const char* labels[size]>
-void Counter<size, labels>::Add(const unsigned int& index, const uint32_t& weight)
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+void Counter<size, labels, mode>::Add(const unsigned int& index, const uint32_t& weight)
 {
-  if (index > size) {
-    LOG(FATAL) << "Incrementing counter too far! " << index << "/" << size;
+  if constexpr (mode == CounterMode::Checked) {
+    if (index >= size) {
+      LOG(FATAL) << "Incrementing counter too far! " << index << "/" << size;
+    }
+    LOG(DEBUG) << "Incrementing " << index << "/" << size << " of " << weight << " to " << counter[index];
+    counter[index] += weight;
+  } else if constexpr (mode == CounterMode::Atomic) {
+    counter[index].fetch_add(weight, std::memory_order_relaxed);
+  } else {
+    counter[index] += weight;
   }
-  LOG(DEBUG) << "Incrementing " << index << "/" << size << " of " << weight << " to " << counter[index];
-  counter[index] += weight;
 }
 
-template <const unsigned int size, const char* labels[size]>
-void Counter<size, labels>::Reset()
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+void Counter<size, labels, mode>::Reset()
 {
   LOG(DEBUG) << "Resetting Counter";
   for (unsigned int i = 0; i < size; i++) {
@@ -126,8 +151,8 @@ void Counter<size, labels>::Reset()
   }
 }
 
-template <const unsigned int size, const char* labels[size]>
-constexpr bool Counter<size, labels>::HasLabel(const unsigned int& index) const
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+constexpr bool Counter<size, labels, mode>::HasLabel(const unsigned int& index) const
 {
   if constexpr (labels != nullptr) {
     return (labels[index] && labels[index][0]);
@@ -135,8 +160,8 @@ constexpr bool Counter<size, labels>::HasLabel(const unsigned int& index) const
   return false;
 }
 
-template <const unsigned int size, const char* labels[size]>
-void Counter<size, labels>::Print()
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+void Counter<size, labels, mode>::Print()
 {
   for (unsigned int i = 0; i < size; i++) {
     if (labels != nullptr) {
@@ -147,8 +172,8 @@ void Counter<size, labels>::Print()
   }
 }
 
-template <const unsigned int size, const char* labels[size]>
-uint32_t Counter<size, labels>::Total()
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+uint32_t Counter<size, labels, mode>::Total()
 {
   uint32_t sum = 0;
   for (unsigned int i = 0; i < size; i++) {
@@ -158,23 +183,23 @@ uint32_t Counter<size, labels>::Total()
   return sum;
 }
 
-template <const unsigned int size, const char* labels[size]>
-uint32_t Counter<size, labels>::TotalNew()
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+uint32_t Counter<size, labels, mode>::TotalNew()
 {
   uint32_t sum = mTotal;
   return sum - Total();
 }
 
-template <const unsigned int size, const char* labels[size]>
-uint32_t Counter<size, labels>::TotalAndReset()
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+uint32_t Counter<size, labels, mode>::TotalAndReset()
 {
   uint32_t sum = Total();
   Reset();
   return sum;
 }
 
-template <const unsigned int size, const char* labels[size]>
-int Counter<size, labels>::MakeHistogram(TH1* histogram) const
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+int Counter<size, labels, mode>::MakeHistogram(TH1* histogram) const
 {
   LOG(DEBUG) << "Making Histogram " << histogram->GetName() << " to accomodate counter of size " << size;
   TAxis* axis = histogram->GetXaxis();
@@ -231,22 +256,23 @@ int Counter<size, labels>::MakeHistogram(TH1* histogram) const
   return 0;
 }
 
-template <const unsigned int size, const char* labels[size]>
-int Counter<size, labels>::FillHistogram(TH1* histogram, const unsigned int& biny, const unsigned int& binz) const
+template <const unsigned int size, const char* labels[size], CounterMode mode>
+int Counter<size, labels, mode>::FillHistogram(TH1* histogram, const unsigned int& biny, const unsigned int& binz) const
 {
   auto fillIt = [&](const unsigned int& bin, const unsigned int& index) {
-    if (counter[index] > 0) {
+    const uint32_t count = HowMany(index);
+    if (count > 0) {
       if (biny > 0) {
         if (binz > 0) {
-          histogram->SetBinContent(bin, biny, binz, counter[index]);
-          histogram->SetBinError(bin, biny, binz, TMath::Sqrt(counter[index]));
+          histogram->SetBinContent(bin, biny, binz, count);
+          histogram->SetBinError(bin, biny, binz, TMath::Sqrt(count));
         } else {
-          histogram->SetBinContent(bin, biny, counter[index]);
-          histogram->SetBinError(bin, biny, TMath::Sqrt(counter[index]));
+          histogram->SetBinContent(bin, biny, count);
+          histogram->SetBinError(bin, biny, TMath::Sqrt(count));
         }
       } else {
-        histogram->SetBinContent(bin, counter[index]);
-        histogram->SetBinError(bin, TMath::Sqrt(counter[index]));
+        histogram->SetBinContent(bin, count);
+        histogram->SetBinError(bin, TMath::Sqrt(count));
       }
     }
   };
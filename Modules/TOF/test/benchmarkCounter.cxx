@@ -0,0 +1,103 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkCounter.cxx
+/// \author Piotr Konopka
+///
+
+#include "Base/Counter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2::quality_control_modules::tof;
+
+// Measures the counting done by the TOF raw decoder for each hit (see RawDataDecoder::frameHandler), in the
+// different modes of the Counter. CounterMode::Checked reproduces the former behaviour as a reference.
+
+namespace
+{
+
+constexpr unsigned int nequipments = 172800;
+
+struct Hit {
+  unsigned int drmID;
+  unsigned int trmID;
+  unsigned int chain;
+  unsigned int tdcID;
+  unsigned int channel;
+  int time;
+};
+
+const std::vector<Hit>& getHits()
+{
+  static const std::vector<Hit> hits = [] {
+    std::mt19937 generator(42);
+    auto random = [&generator](unsigned int n) { return static_cast<unsigned int>(generator() % n); };
+    std::vector<Hit> result(1 << 16);
+    for (auto& hit : result) {
+      hit = { random(72), 3 + random(10), random(2), random(15), random(8), static_cast<int>(random(1 << 21)) };
+    }
+    return result;
+  }();
+  return hits;
+}
+
+template <CounterMode mode>
+struct Counters {
+  Counter<nequipments, nullptr, mode> indexEquipment;
+  Counter<1024, nullptr, mode> timeBC;
+};
+
+template <CounterMode mode>
+void decode(const std::vector<Hit>& hits, Counters<mode>& counters)
+{
+  for (const auto& hit : hits) {
+    const auto indexE = hit.channel + 8 * hit.tdcID + 120 * hit.chain + 240 * (hit.trmID - 3) + 2400 * hit.drmID;
+    counters.indexEquipment.Count(indexE);
+    counters.timeBC.Count(hit.time % 1024);
+  }
+}
+
+} // namespace
+
+template <CounterMode mode>
+static void BM_DecodeHits(benchmark::State& state)
+{
+  const auto& hits = getHits();
+  auto counters = std::make_unique<Counters<mode>>();
+  for (auto _ : state) {
+    decode(hits, *counters);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+
+// all the threads count into the same counters
+static void BM_DecodeHitsConcurrently(benchmark::State& state)
+{
+  static auto counters = std::make_unique<Counters<CounterMode::Atomic>>();
+  const auto& hits = getHits();
+  for (auto _ : state) {
+    decode(hits, *counters);
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+
+BENCHMARK_TEMPLATE(BM_DecodeHits, CounterMode::Checked);
+BENCHMARK_TEMPLATE(BM_DecodeHits, CounterMode::Fast);
+BENCHMARK_TEMPLATE(BM_DecodeHits, CounterMode::Atomic);
+BENCHMARK(BM_DecodeHitsConcurrently)->Threads(1)->Threads(2)->Threads(4);
+
+BENCHMARK_MAIN();
@@ -18,6 +18,9 @@
 #include "DataFormatsTOF/CompressedDataFormat.h"
 #include "TH1F.h"
 
+#include <thread>
+#include <vector>
+
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
@@ -98,4 +101,42 @@ BOOST_AUTO_TEST_CASE(check_tof_counter)
   BOOST_TEST_CHECKPOINT("Ending");
   BOOST_CHECK(true);
 }
-} // namespace o2::quality_control_modules::tof
\ No newline at end of file
+
+BOOST_AUTO_TEST_CASE(check_tof_counter_modes)
+{
+  Counter<32, o2::tof::diagnostic::DRMDiagnosticName, CounterMode::Checked> counterChecked;
+  Counter<32, o2::tof::diagnostic::DRMDiagnosticName, CounterMode::Fast> counterFast;
+  Counter<32, o2::tof::diagnostic::DRMDiagnosticName, CounterMode::Atomic> counterAtomic;
+  for (unsigned int j = 0; j < 32; j++) {
+    counterChecked.Add(j, j);
+    counterFast.Add(j, j);
+  }
+  counterChecked.Count(31);
+  counterFast.Count(31);
+
+  const unsigned int nThreads = 4;
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < nThreads; t++) {
+    threads.emplace_back([&counterAtomic]() {
+      for (unsigned int j = 0; j < 32; j++) {
+        for (unsigned int i = 0; i < j; i++) {
+          counterAtomic.Count(j);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (unsigned int j = 0; j < 32; j++) {
+    const unsigned int expected = j + (j == 31);
+    BOOST_CHECK_EQUAL(counterChecked.HowMany(j), expected);
+    BOOST_CHECK_EQUAL(counterFast.HowMany(j), expected);
+    BOOST_CHECK_EQUAL(counterAtomic.HowMany(j), nThreads * j);
+  }
+  BOOST_CHECK_EQUAL(counterAtomic.TotalAndReset(), nThreads * 31 * 32 / 2);
+  BOOST_CHECK_EQUAL(counterAtomic.Total(), 0);
+}
+
+} // namespace o2::quality_control_modules::tof